@@ -0,0 +1,61 @@
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace Bench
+{
+	// Keeps The Optimizer From Dropping A Result
+	template<typename T>
+	inline void DoNotOptimize(const T& value)
+	{
+#if defined(__GNUC__) || defined(__clang__)
+		asm volatile("" : : "r,m"(value) : "memory");
+#else
+		static volatile const void* sink;
+		sink = &value;
+#endif
+	}
+
+	// Run body() repeat Times, Return The Best Wall Time In Seconds
+	template<typename Body>
+	inline double Measure(Body body, int repeat = 3)
+	{
+		double best = 0;
+		for (int i = 0; i < repeat; ++i)
+		{
+			auto start = std::chrono::steady_clock::now();
+			body();
+			double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+			if (i == 0 || seconds < best)
+				best = seconds;
+		}
+
+		return best;
+	}
+
+	// One Line Of The Report: name, total ops, seconds
+	inline void Report(const std::string& name, double ops, double seconds)
+	{
+		std::printf("%-44s %10.2f Mops/s %10.1f ns/op\n", name.c_str(), ops / seconds / 1e6, seconds / ops * 1e9);
+	}
+
+	// Bandwidth Line Of The Report: bytes moved, seconds
+	inline void ReportBandwidth(const std::string& name, double bytes, double seconds)
+	{
+		std::printf("%-44s %10.2f GB/s\n", name.c_str(), bytes / seconds / 1e9);
+	}
+
+	// Latency Line Of The Report: p50 / p99 / p99.9 of samples (nanoseconds)
+	inline void ReportPercentiles(const std::string& name, std::vector<double> samples)
+	{
+		if (samples.empty())
+			return;
+
+		std::sort(samples.begin(), samples.end());
+		auto at = [&](double fraction) { return samples[static_cast<std::size_t>(fraction * (samples.size() - 1))]; };
+		std::printf("%-44s p50 %8.1f  p99 %8.1f  p99.9 %8.1f ns\n", name.c_str(), at(0.5), at(0.99), at(0.999));
+	}
+}
@@ -0,0 +1,84 @@
+#include "AVLTree.hpp"
+#include "Bench.hpp"
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+// counts restructurings (a double rotation is one) of the trees it augments
+struct CountRotations : Tree::NoAugment
+{
+	static std::size_t count;
+
+	template<typename Node>
+	static void rotate(const Node*) { ++count; }
+};
+std::size_t CountRotations::count = 0;
+
+struct Op
+{
+	bool insert;
+	int key;
+};
+
+// insert-only, 50 / 50 and erase-heavy (60% erases from a full tree) mixes over one key range
+static std::vector<Op> Workload(int erase_percent, std::size_t count, int range, std::mt19937& gen)
+{
+	std::vector<Op> ops;
+	for (std::size_t i = 0; i < count; ++i)
+		ops.push_back({ static_cast<int>(gen() % 100) >= erase_percent, static_cast<int>(gen() % range) });
+	return ops;
+}
+
+template<typename Balancing>
+static void Run(const char* policy, const char* mix, const std::vector<int>& prefill, const std::vector<Op>& ops)
+{
+	using tree_type = Tree::AVLTree<int, unsigned char, CountRotations, Balancing>;
+
+	// best of 3, the prefill is not timed
+	std::size_t rotations = 0;
+	double seconds = 0;
+	for (int repeat = 0; repeat < 3; ++repeat)
+	{
+		tree_type tree;
+		for (int key : prefill)
+			tree.insert(key);
+
+		CountRotations::count = 0;
+		std::size_t changed = 0;
+		double once = Bench::Measure([&]() {
+			for (const Op& op : ops)
+				changed += op.insert ? tree.insert(op.key) : tree.erase(op.key);
+		}, 1);
+		Bench::DoNotOptimize(changed);
+
+		rotations = CountRotations::count;
+		if (repeat == 0 || once < seconds)
+			seconds = once;
+	}
+
+	Bench::Report(std::string(policy) + " " + mix, static_cast<double>(ops.size()), seconds);
+	std::printf("%-44s %10.3f rotations/op\n", "", static_cast<double>(rotations) / ops.size());
+}
+
+int main()
+{
+	const int range = 60000;
+	const std::size_t count = 400000;
+	std::mt19937 gen(42);
+
+	std::vector<int> prefill;
+	for (int i = 0; i < range; i += 2)
+		prefill.push_back(static_cast<int>(gen() % range));
+
+	struct Mix { const char* name; int erase_percent; };
+	for (Mix mix : { Mix{ "insert only", 0 }, Mix{ "50% erase", 50 }, Mix{ "60% erase churn", 60 } })
+	{
+		std::vector<Op> ops = Workload(mix.erase_percent, count, range, gen);
+		Run<Tree::AVLBalancing>("AVL", mix.name, prefill, ops);
+		Run<Tree::WAVLBalancing>("WAVL", mix.name, prefill, ops);
+		Run<Tree::WeightBalancing>("weight-balanced", mix.name, prefill, ops);
+	}
+
+	return 0;
+}
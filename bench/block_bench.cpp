@@ -0,0 +1,70 @@
+#include "AVLTree.hpp"
+#include "BlockAVLTree.hpp"
+#include "Bench.hpp"
+#include <algorithm>
+#include <random>
+#include <vector>
+
+// per-key heap bytes, with a 16-byte allocator header per allocation
+static double BytesPerKey(std::size_t nodes, std::size_t node_bytes, std::size_t keys)
+{
+	return double(nodes * (node_bytes + 16)) / keys;
+}
+
+template<typename Tree_t>
+static void Run(const char* name, const std::vector<int>& keys, const std::vector<int>& probes)
+{
+	double insert = Bench::Measure([&]() {
+		Tree_t tree;
+		for (int key : keys)
+			tree.insert(key);
+		Bench::DoNotOptimize(tree);
+	}, 1);
+
+	Tree_t tree;
+	for (int key : keys)
+		tree.insert(key);
+
+	double find = Bench::Measure([&]() {
+		std::size_t found = 0;
+		for (int key : probes)
+			found += tree.find(key) != nullptr;
+		Bench::DoNotOptimize(found);
+	});
+
+	double scan = Bench::Measure([&]() {
+		long long sum = 0;
+		for (int key : tree)
+			sum += key;
+		Bench::DoNotOptimize(sum);
+	}, 1);
+
+	Bench::Report(std::string(name) + " insert", keys.size(), insert);
+	Bench::Report(std::string(name) + " find", probes.size(), find);
+	Bench::Report(std::string(name) + " iterate", keys.size(), scan);
+}
+
+int main()
+{
+	const std::size_t count = 1000000;
+	std::mt19937 gen(31);
+
+	std::vector<int> keys(count);
+	for (int& key : keys)
+		key = static_cast<int>(gen());
+	std::vector<int> probes = keys;
+	std::shuffle(probes.begin(), probes.end(), gen);
+
+	Run<Tree::AVLTree<int>>("AVLTree<int>", keys, probes);
+	Run<Tree::BlockAVLTree<int, 16>>("BlockAVLTree<int, 16>", keys, probes);
+	Run<Tree::BlockAVLTree<int, 32>>("BlockAVLTree<int, 32>", keys, probes);
+	Run<Tree::BlockAVLTree<int, 64>>("BlockAVLTree<int, 64>", keys, probes);
+
+	Tree::BlockAVLTree<int, 32> blocks;
+	for (int key : keys)
+		blocks.insert(key);
+
+	std::printf("bytes per key: AVLTree<int> %.1f, BlockAVLTree<int, 32> %.1f\n",
+		BytesPerKey(count, sizeof(Tree::AVLTree<int>::Node), count),
+		BytesPerKey(blocks.block_count(), blocks.block_bytes(), blocks.size()));
+}
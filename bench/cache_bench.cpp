@@ -0,0 +1,92 @@
+#include "AVLTree.hpp"
+#include "AVLCache.hpp"
+#include "Bench.hpp"
+#include <list>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+// external eviction: AVLTree + recency list + key index, find + erase per eviction
+class ExternalLru
+{
+private:
+	Tree::AVLTree<int> tree;
+	std::list<int> recency;
+	std::unordered_map<int, std::list<int>::iterator> index;
+	std::size_t capacity;
+
+public:
+	explicit ExternalLru(std::size_t capacity) : capacity(capacity) {}
+
+	bool find(int key)
+	{
+		if (tree.find(key) == nullptr)
+			return false;
+		recency.splice(recency.begin(), recency, index[key]);
+		return true;
+	}
+
+	void insert(int key)
+	{
+		if (!tree.insert(key))
+			return;
+		recency.push_front(key);
+		index[key] = recency.begin();
+		if (recency.size() > capacity)
+		{
+			int victim = recency.back();
+			recency.pop_back();
+			index.erase(victim);
+			if (tree.find(victim) != nullptr)
+				tree.erase(victim);
+		}
+	}
+};
+
+int main()
+{
+	const unsigned short capacity = 20000;
+	const std::size_t ops = 2000000;
+	std::mt19937 gen(28);
+
+	// skewed keys: most probes hit a hot range, the tail forces evictions
+	std::vector<int> keys(ops);
+	std::uniform_int_distribution<int> hot(0, capacity / 2), cold(0, capacity * 8);
+	for (int& key : keys)
+		key = (gen() % 10 < 8) ? hot(gen) : cold(gen);
+
+	std::size_t hits = 0, evictions = 0;
+	double avl_cache = Bench::Measure([&]() {
+		Tree::AVLCache<int> cache(capacity);
+		hits = evictions = 0;
+		for (int key : keys)
+		{
+			if (cache.find(key) != nullptr)
+				++hits;
+			else
+			{
+				evictions += cache.size() == capacity;
+				cache.insert(key);
+			}
+		}
+	});
+
+	double external = Bench::Measure([&]() {
+		ExternalLru cache(capacity);
+		std::size_t found = 0;
+		for (int key : keys)
+		{
+			if (cache.find(key))
+				++found;
+			else
+				cache.insert(key);
+		}
+		Bench::DoNotOptimize(found);
+	});
+
+	std::printf("hit ratio %.3f, evictions %zu\n", double(hits) / ops, evictions);
+	Bench::Report("AVLCache find/insert", ops, avl_cache);
+	Bench::Report("AVLCache evictions", evictions, avl_cache);
+	Bench::Report("AVLTree + list + map find/insert", ops, external);
+	Bench::Report("AVLTree + list + map evictions", evictions, external);
+}
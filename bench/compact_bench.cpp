@@ -0,0 +1,86 @@
+#include "AVLTree.hpp"
+#include "Bench.hpp"
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <random>
+#include <vector>
+
+// find() over every key in random order + one full in-order walk
+static void Lookups(const char* name, const Tree::AVLTree<int>& tree, const std::vector<int>& probes)
+{
+	double find = Bench::Measure([&]() {
+		std::size_t found = 0;
+		for (int key : probes)
+			found += tree.find(key) != nullptr;
+		Bench::DoNotOptimize(found);
+	});
+
+	double walk = Bench::Measure([&]() {
+		long long sum = 0;
+		for (auto it = tree.cursor_begin(); it != tree.cursor_end(); ++it)
+			sum += *it;
+		Bench::DoNotOptimize(sum);
+	});
+
+	Bench::Report(std::string(name) + " find()", static_cast<double>(probes.size()), find);
+	Bench::Report(std::string(name) + " cursor walk", tree.size(), walk);
+}
+
+int main()
+{
+	const int count = 60000, rounds = 40;
+	std::mt19937 gen(39);
+
+	// long-lived tree: rounds of erase + reinsert while other allocations come and go
+	Tree::AVLTree<int> churned;
+	std::vector<int> keys;
+	for (int i = 0; i < count; ++i)
+	{
+		int key = static_cast<int>(gen());
+		if (churned.insert(key))
+			keys.push_back(key);
+	}
+
+	std::vector<std::unique_ptr<char[]>> noise;
+	for (int round = 0; round < rounds; ++round)
+	{
+		std::shuffle(keys.begin(), keys.end(), gen);
+		for (std::size_t i = 0; i < keys.size() / 4; ++i)
+		{
+			churned.erase(keys[i]);
+			noise.emplace_back(new char[16 + gen() % 48]);
+		}
+		for (std::size_t i = 0; i < keys.size() / 4; ++i)
+		{
+			churned.insert(keys[i]);
+			if (gen() % 2)
+				noise[gen() % noise.size()].reset();
+		}
+	}
+
+	std::vector<int> probes = keys;
+	std::shuffle(probes.begin(), probes.end(), gen);
+
+	Tree::AVLTree<int> fresh;
+	for (int key : keys)
+		fresh.insert(key);
+
+	Lookups("churned", churned, probes);
+
+	// incremental: idle-time steps of 1024 links
+	double worst_step = 0;
+	int steps = 0;
+	auto start = std::chrono::steady_clock::now();
+	for (bool done = false; !done; ++steps)
+	{
+		auto step_start = std::chrono::steady_clock::now();
+		done = churned.compact_step(1024);
+		worst_step = std::max(worst_step, std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - step_start).count());
+	}
+	double total = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	std::printf("compact_step(1024): %d steps, worst %.1f us, mean %.1f us\n", steps, worst_step, total * 1000 / steps);
+
+	Lookups("churned + compact()", churned, probes);
+	Lookups("freshly built", fresh, probes);
+}
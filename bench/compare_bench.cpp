@@ -0,0 +1,43 @@
+#include "AVLTree.hpp"
+#include "HashedAVLTree.hpp"
+#include "Bench.hpp"
+#include <algorithm>
+#include <random>
+#include <vector>
+
+int main()
+{
+	const int count = 60000;
+	std::mt19937 gen(32);
+
+	// two replicas with the same contents built in different orders, then d differences
+	std::vector<int> keys(count);
+	for (int i = 0; i < count; ++i)
+		keys[i] = i * 2;
+
+	Tree::HashedAVLTree<int> mine, others;
+	for (int key : keys)
+		mine.insert(key);
+	std::shuffle(keys.begin(), keys.end(), gen);
+	for (int key : keys)
+		others.insert(key);
+
+	double equal_lockstep = Bench::Measure([&]() { Bench::DoNotOptimize(mine == others); });
+	double equal_hash = Bench::Measure([&]() { Bench::DoNotOptimize(mine.equal(others)); });
+	std::printf("equal replicas: operator== (in-order) %10.1f us, equal() (hash) %10.3f us\n", equal_lockstep * 1e6, equal_hash * 1e6);
+
+	for (int d : {1, 10, 100, 1000})
+	{
+		Tree::HashedAVLTree<int> changed = others;
+		for (int i = 0; i < d; ++i)
+			changed.insert(static_cast<int>(gen() % count) * 2 + 1);
+
+		std::size_t found = 0;
+		double diff = Bench::Measure([&]() {
+			found = 0;
+			mine.diff(changed, [&found](int, bool) { ++found; });
+		});
+
+		std::printf("d = %4d: diff() %10.1f us (%zu reported)\n", d, diff * 1e6, found);
+	}
+}
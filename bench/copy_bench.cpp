@@ -0,0 +1,58 @@
+#include "AVLTree.hpp"
+#include "Bench.hpp"
+#include <random>
+#include <vector>
+
+// AVLTree as it was before: the move constructor may throw, so vector growth copies
+struct LegacyTree : Tree::AVLTree<int>
+{
+	LegacyTree() = default;
+	LegacyTree(const LegacyTree&) = default;
+	LegacyTree(LegacyTree&& other) noexcept(false) : Tree::AVLTree<int>(std::move(other)) { }
+};
+
+template<typename Shard>
+static void Grow(int shards, int keys)
+{
+	std::vector<Shard> vector;
+	for (int i = 0; i < shards; ++i)
+	{
+		vector.emplace_back();
+		for (int key = 0; key < keys; ++key)
+			vector.back().insert(key);
+	}
+	Bench::DoNotOptimize(vector.data());
+}
+
+int main()
+{
+	const int shards = 2000, keys = 64;
+
+	double legacy = Bench::Measure([&]() { Grow<LegacyTree>(shards, keys); });
+	double nothrow = Bench::Measure([&]() { Grow<Tree::AVLTree<int>>(shards, keys); });
+
+	Bench::Report("vector<AVLTree> growth, throwing move (copies)", shards, legacy);
+	Bench::Report("vector<AVLTree> growth, noexcept move", shards, nothrow);
+
+	const int count = 50000;
+	std::mt19937 gen(34);
+	Tree::AVLTree<int> source, target;
+	for (int i = 0; i < count; ++i)
+	{
+		source.insert(static_cast<int>(gen()));
+		target.insert(static_cast<int>(gen()));
+	}
+
+	double fresh = Bench::Measure([&]() {
+		Tree::AVLTree<int> copy(source);
+		Bench::DoNotOptimize(copy.size());
+	});
+
+	double reuse = Bench::Measure([&]() {
+		target = source;
+		Bench::DoNotOptimize(target.size());
+	});
+
+	Bench::Report("copy construct (fresh nodes)", count, fresh);
+	Bench::Report("copy assign over a full tree (reused nodes)", count, reuse);
+}
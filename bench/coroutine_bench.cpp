@@ -0,0 +1,66 @@
+#include "Bench.hpp"
+#include "CoroutineLookup.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+// random lookups: sequential find() vs LookupScheduler interleaving width coroutine descents,
+// on one cache-resident tree and on a forest of full trees well beyond the last level cache
+// usage: coroutineBench [trees] (default 256 x 60000 nodes)
+int main(int argc, char** argv)
+{
+	const int per_tree = 60000;
+	const std::size_t lookups = 2000000;
+	const int forest_size = argc > 1 ? std::atoi(argv[1]) : 256;
+	std::mt19937 gen(50);
+
+	for (int trees : { 1, forest_size })
+	{
+		std::vector<Tree::AVLTree<int>> forest(trees);
+		std::vector<std::vector<int>> present(trees);
+		for (int t = 0; t < trees; ++t)
+		{
+			for (int i = 0; i < per_tree; ++i)
+			{
+				int key = static_cast<int>(gen());
+				if (forest[t].insert(key))
+					present[t].push_back(key);
+			}
+		}
+
+		// 3 of 4 keys present
+		std::vector<std::pair<int, int>> queries(lookups);
+		for (std::pair<int, int>& query : queries)
+		{
+			query.first = static_cast<int>(gen() % trees);
+			const std::vector<int>& keys = present[query.first];
+			query.second = gen() % 4 ? keys[gen() % keys.size()] : static_cast<int>(gen());
+		}
+
+		const std::string size = " (" + std::to_string(trees) + " x " + std::to_string(per_tree) + " nodes)";
+		std::vector<const Tree::AVLTree<int>::Node*> out(lookups);
+
+		double sequential = Bench::Measure([&]() {
+			for (std::size_t i = 0; i < lookups; ++i)
+				out[i] = forest[queries[i].first].find(queries[i].second);
+			Bench::DoNotOptimize(out.data());
+		});
+		Bench::Report("sequential find()" + size, static_cast<double>(lookups), sequential);
+
+		for (std::size_t width : { 8, 16, 32, 64 })
+		{
+			Tree::LookupScheduler<Tree::AVLTree<int>> scheduler(width);
+			double interleaved = Bench::Measure([&]() {
+				for (std::size_t i = 0; i < lookups; ++i)
+					scheduler.submit(forest[queries[i].first], queries[i].second, &out[i]);
+				scheduler.run();
+				Bench::DoNotOptimize(out.data());
+			});
+			Bench::Report("LookupScheduler width " + std::to_string(width) + size, static_cast<double>(lookups), interleaved);
+		}
+	}
+
+	return 0;
+}
@@ -0,0 +1,102 @@
+#include "AVLTree.hpp"
+#include "DurableAVLTree.hpp"
+#include "Bench.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <numeric>
+#include <random>
+#include <string>
+#include <sys/stat.h>
+#include <vector>
+
+static void Clean(const std::string& directory)
+{
+	for (const char* name : {"/snapshot", "/log", "/snapshot.tmp", "/log.tmp"})
+		std::remove((directory + name).c_str());
+}
+
+// keys inserted one by one, then the tree is closed (last group committed)
+static double Inserts(const std::string& directory, const Tree::DurableOptions& options, const std::vector<int>& keys)
+{
+	return Bench::Measure([&]() {
+		Clean(directory);
+		Tree::DurableAVLTree<int> tree(directory, options);
+		for (int key : keys)
+			tree.insert(key);
+	}, 1);
+}
+
+static std::string Name(std::size_t batch, long long interval, std::size_t checkpoint)
+{
+	return "batch " + std::to_string(batch) + " sync " + std::to_string(interval) + "ms ckpt " + std::to_string(checkpoint);
+}
+
+// argv[1]: directory on the filesystem to measure (default ./durable_bench)
+int main(int argc, char** argv)
+{
+	const std::string directory = argc > 1 ? argv[1] : "durable_bench";
+	mkdir(directory.c_str(), 0755);
+
+	const std::size_t count = 20000;
+	std::vector<int> keys(count);
+	std::iota(keys.begin(), keys.end(), 0);
+	std::shuffle(keys.begin(), keys.end(), std::mt19937(40));
+
+	double memory = Bench::Measure([&]() {
+		Tree::AVLTree<int> tree;
+		for (int key : keys)
+			tree.insert(key);
+		Bench::DoNotOptimize(tree.size());
+	});
+	Bench::Report("in-memory AVLTree", count, memory);
+
+	// every write durable on return (batch 1) ... one fsync per few thousand writes
+	for (std::size_t batch : {1, 8, 64, 512, 4096})
+	{
+		Tree::DurableOptions options;
+		options.batch = batch;
+		options.sync_interval = std::chrono::milliseconds(0);
+		options.checkpoint_every = 0;
+		std::vector<int> part(keys.begin(), keys.begin() + (batch == 1 ? count / 10 : count));
+		Bench::Report(Name(batch, 0, 0), part.size(), Inserts(directory, options, part));
+	}
+
+	// big batches, bounded by time instead
+	for (long long interval : {1, 10, 100})
+	{
+		Tree::DurableOptions options;
+		options.batch = 1 << 20;
+		options.sync_interval = std::chrono::milliseconds(interval);
+		options.checkpoint_every = 0;
+		Bench::Report(Name(options.batch, interval, 0), count, Inserts(directory, options, keys));
+	}
+
+	// snapshot cost folded into the writes
+	for (std::size_t checkpoint : {1000, 5000})
+	{
+		Tree::DurableOptions options;
+		options.checkpoint_every = checkpoint;
+		Bench::Report(Name(options.batch, options.sync_interval.count(), checkpoint), count, Inserts(directory, options, keys));
+	}
+
+	// recovery: snapshot of count / 2 + log tail of count / 2
+	Clean(directory);
+	{
+		Tree::DurableOptions options;
+		options.checkpoint_every = 0;
+		Tree::DurableAVLTree<int> tree(directory, options);
+		for (std::size_t i = 0; i < count / 2; ++i)
+			tree.insert(keys[i]);
+		tree.checkpoint();
+		for (std::size_t i = count / 2; i < count; ++i)
+			tree.insert(keys[i]);
+	}
+	double recover = Bench::Measure([&]() {
+		Tree::DurableAVLTree<int> tree(directory);
+		Bench::DoNotOptimize(tree.size());
+	}, 1);
+	Bench::Report("recovery (snapshot + log tail, per element)", count, recover);
+
+	Clean(directory);
+}
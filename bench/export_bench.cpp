@@ -0,0 +1,74 @@
+#include "AVLTree.hpp"
+#include "Bench.hpp"
+#include <random>
+#include <string>
+#include <vector>
+
+// full scans: cursor loop vs the prefetching for_each / copy_to / export_range, as GB/s of keys delivered
+// (many trees back to back, so the node graph is well beyond the last level cache)
+int main()
+{
+	const int trees = 64, per_tree = 60000;
+	std::mt19937 gen(46);
+
+	std::vector<Tree::AVLTree<long long>> forest(trees);
+	for (Tree::AVLTree<long long>& tree : forest)
+	{
+		for (int i = 0; i < per_tree; ++i)
+			tree.insert(static_cast<long long>(gen()));
+	}
+
+	std::size_t total = 0;
+	for (const Tree::AVLTree<long long>& tree : forest)
+		total += tree.size();
+	std::vector<long long> buffer(total);
+	const double bytes = static_cast<double>(total * sizeof(long long));
+
+	for (int compacted = 0; compacted < 2; ++compacted)
+	{
+		const std::string layout = compacted ? " (compact)" : " (insert order)";
+
+		double cursor = Bench::Measure([&]() {
+			long long* out = buffer.data();
+			for (const Tree::AVLTree<long long>& tree : forest)
+				for (auto it = tree.cursor_begin(); it != tree.cursor_end(); ++it)
+					*out++ = *it;
+			Bench::DoNotOptimize(buffer.data());
+		});
+
+		double for_each = Bench::Measure([&]() {
+			long long* out = buffer.data();
+			for (const Tree::AVLTree<long long>& tree : forest)
+				tree.for_each([&out](long long value) { *out++ = value; });
+			Bench::DoNotOptimize(buffer.data());
+		});
+
+		double copy_to = Bench::Measure([&]() {
+			long long* out = buffer.data();
+			for (const Tree::AVLTree<long long>& tree : forest)
+				out = tree.copy_to(out);
+			Bench::DoNotOptimize(buffer.data());
+		});
+
+		double export_range = Bench::Measure([&]() {
+			long long* out = buffer.data();
+			for (const Tree::AVLTree<long long>& tree : forest)
+				out += tree.export_range(LLONG_MIN, LLONG_MAX, out, per_tree);
+			Bench::DoNotOptimize(buffer.data());
+		});
+
+		Bench::Report("cursor loop" + layout, static_cast<double>(total), cursor);
+		Bench::ReportBandwidth("cursor loop" + layout, bytes, cursor);
+		Bench::Report("for_each" + layout, static_cast<double>(total), for_each);
+		Bench::ReportBandwidth("for_each" + layout, bytes, for_each);
+		Bench::Report("copy_to" + layout, static_cast<double>(total), copy_to);
+		Bench::ReportBandwidth("copy_to" + layout, bytes, copy_to);
+		Bench::Report("export_range" + layout, static_cast<double>(total), export_range);
+		Bench::ReportBandwidth("export_range" + layout, bytes, export_range);
+
+		for (Tree::AVLTree<long long>& tree : forest)
+			tree.compact();
+	}
+
+	return 0;
+}
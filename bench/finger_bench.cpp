@@ -0,0 +1,83 @@
+#include "AVLTree.hpp"
+#include "Bench.hpp"
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+// keys[i] < keys[i + 1]: ingest in order, then probes that drift a few ranks at a time
+template<typename Key>
+static void Run(const char* name, const std::vector<Key>& keys)
+{
+	const int count = static_cast<int>(keys.size());
+
+	double insert = Bench::Measure([&]() {
+		Tree::AVLTree<Key> tree;
+		for (const Key& key : keys)
+			tree.insert(key);
+		Bench::DoNotOptimize(tree.size());
+	});
+
+	double insert_near = Bench::Measure([&]() {
+		Tree::AVLTree<Key> tree;
+		typename Tree::AVLTree<Key>::finger hint;
+		for (const Key& key : keys)
+			tree.insert_near(hint, key);
+		Bench::DoNotOptimize(tree.size());
+	});
+
+	std::mt19937 gen(35);
+	std::vector<int> probes(count);
+	int rank = count / 2;
+	for (int& probe : probes)
+	{
+		rank += static_cast<int>(gen() % 17) - 8;
+		rank = (rank < 0 ? 0 : rank >= count ? count - 1 : rank);
+		probe = rank;
+	}
+
+	Tree::AVLTree<Key> tree;
+	for (const Key& key : keys)
+		tree.insert(key);
+
+	double find = Bench::Measure([&]() {
+		const void* last = nullptr;
+		for (int probe : probes)
+			last = tree.find(keys[probe]);
+		Bench::DoNotOptimize(last);
+	});
+
+	double find_from = Bench::Measure([&]() {
+		const void* last = nullptr;
+		typename Tree::AVLTree<Key>::finger hint;
+		for (int probe : probes)
+			last = tree.find_from(hint, keys[probe]);
+		Bench::DoNotOptimize(last);
+	});
+
+	std::string prefix(name);
+	Bench::Report(prefix + " sequential ingest insert()", count, insert);
+	Bench::Report(prefix + " sequential ingest insert_near()", count, insert_near);
+	Bench::Report(prefix + " drifting probes find()", count, find);
+	Bench::Report(prefix + " drifting probes find_from()", count, find_from);
+}
+
+int main()
+{
+	const int count = 60000;
+
+	std::vector<int> ints(count);
+	for (int i = 0; i < count; ++i)
+		ints[i] = i;
+
+	std::vector<std::string> urls(count);
+	for (int i = 0; i < count; ++i)
+	{
+		char url[64];
+		std::snprintf(url, sizeof(url), "https://example.com/catalog/items/%08d", i);
+		urls[i] = url;
+	}
+
+	Run("int", ints);
+	Run("url", urls);
+}
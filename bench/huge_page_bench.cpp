@@ -0,0 +1,114 @@
+#include "AVLTree.hpp"
+#include "HugePageStorage.hpp"
+#include "Bench.hpp"
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// dTLB Load Misses Of This Thread (perf_event_open), -1 When The Counter Is Not Available
+class TLBCounter
+{
+private:
+	int fd = -1;
+
+public:
+	TLBCounter()
+	{
+#if defined(__linux__)
+		perf_event_attr attr = {};
+		attr.size = sizeof(attr);
+		attr.type = PERF_TYPE_HW_CACHE;
+		attr.config = PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+		attr.disabled = 1;
+		attr.exclude_kernel = 1;
+		fd = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+#endif
+	}
+
+	~TLBCounter()
+	{
+#if defined(__linux__)
+		if (fd >= 0)
+			close(fd);
+#endif
+	}
+
+	template<typename Body>
+	long long Count(Body body)
+	{
+#if defined(__linux__)
+		if (fd >= 0)
+		{
+			ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+			ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+			body();
+			ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+
+			long long misses = 0;
+			if (read(fd, &misses, sizeof(misses)) == sizeof(misses))
+				return misses;
+		}
+#endif
+		body();
+		return -1;
+	}
+};
+
+// many trees filled round-robin (their nodes interleave in memory), then random lookups across all of them
+template<typename Augment>
+static void Run(const char* name, const std::vector<std::vector<int>>& keys, const std::vector<std::pair<int, int>>& probes)
+{
+	std::vector<Tree::AVLTree<int, unsigned char, Augment>> trees(keys.size());
+	for (std::size_t i = 0; i < keys[0].size(); ++i)
+	{
+		for (std::size_t t = 0; t < keys.size(); ++t)
+			trees[t].insert(keys[t][i]);
+	}
+
+	auto lookups = [&]() {
+		std::size_t found = 0;
+		for (const std::pair<int, int>& probe : probes)
+			found += trees[probe.first].find(keys[probe.first][probe.second]) != nullptr;
+		Bench::DoNotOptimize(found);
+	};
+
+	double seconds = Bench::Measure(lookups);
+	TLBCounter counter;
+	long long misses = counter.Count(lookups);
+
+	Bench::Report(name, static_cast<double>(probes.size()), seconds);
+	if (misses >= 0)
+		std::printf("%-44s %10.3f dTLB misses/lookup\n", name, static_cast<double>(misses) / probes.size());
+	else
+		std::printf("%-44s %10s dTLB misses/lookup (perf counters unavailable)\n", name, "n/a");
+}
+
+int main()
+{
+	const int tree_count = 32, per_tree = 60000, lookups = 2000000;
+	std::mt19937 gen(38);
+
+	std::vector<std::vector<int>> keys(tree_count, std::vector<int>(per_tree));
+	for (std::vector<int>& own : keys)
+	{
+		for (int& key : own)
+			key = static_cast<int>(gen());
+	}
+
+	std::vector<std::pair<int, int>> probes(lookups);
+	for (std::pair<int, int>& probe : probes)
+		probe = { static_cast<int>(gen() % tree_count), static_cast<int>(gen() % per_tree) };
+
+	Run<Tree::NoAugment>("operator new nodes find()", keys, probes);
+	Run<Tree::HugePageStorage<>>("HugePageStorage nodes find()", keys, probes);
+
+	Tree::HugePageArena::Stats stats = Tree::HugePageStorage<>::stats();
+	std::printf("slabs: %zu (MAP_HUGETLB: %zu, MADV_HUGEPAGE: %zu)\n", stats.slabs, stats.huge_slabs, stats.advised_slabs);
+}
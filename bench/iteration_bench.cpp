@@ -0,0 +1,46 @@
+#include "AVLTree.hpp"
+#include "Bench.hpp"
+#include <random>
+
+int main()
+{
+	const int count = 60000;
+	std::mt19937 gen(33);
+
+	Tree::AVLTree<int> tree;
+	for (int i = 0; i < count; ++i)
+		tree.insert(static_cast<int>(gen()));
+
+	double iterator = Bench::Measure([&]() {
+		long long sum = 0;
+		for (auto it = tree.begin(); it != tree.end(); ++it)
+			sum += *it;
+		Bench::DoNotOptimize(sum);
+	});
+
+	double reverse_iterator = Bench::Measure([&]() {
+		long long sum = 0;
+		for (auto it = tree.rbegin(); it != tree.rend(); ++it)
+			sum += *it;
+		Bench::DoNotOptimize(sum);
+	});
+
+	double cursor = Bench::Measure([&]() {
+		long long sum = 0;
+		for (auto it = tree.cursor_begin(); it != tree.cursor_end(); ++it)
+			sum += *it;
+		Bench::DoNotOptimize(sum);
+	});
+
+	double reverse_range = Bench::Measure([&]() {
+		long long sum = 0;
+		for (int value : tree.reverse_range(INT_MIN, INT_MAX))
+			sum += value;
+		Bench::DoNotOptimize(sum);
+	});
+
+	Bench::Report("iterator begin()..end()", count, iterator);
+	Bench::Report("reverse_iterator rbegin()..rend()", count, reverse_iterator);
+	Bench::Report("cursor cursor_begin()..cursor_end()", count, cursor);
+	Bench::Report("reverse_range(INT_MIN, INT_MAX)", count, reverse_range);
+}
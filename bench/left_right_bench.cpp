@@ -0,0 +1,85 @@
+#include "AVLTree.hpp"
+#include "LeftRightAVLTree.hpp"
+#include "Bench.hpp"
+#include <atomic>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+// read-mostly routing table: readers look up all the time, one writer changes a key every millisecond
+static const int keys = 50000, batch = 16, batches = 20000;
+
+// Run readers Threads Of lookup(reader index, key), Return Per-Lookup Latency Of Every Batch (ns)
+template<typename Lookup, typename Update>
+static std::vector<double> Run(int readers, Lookup lookup, Update update)
+{
+	std::atomic<bool> done(false);
+	std::thread writer([&]() {
+		for (int key = keys; !done.load(); ++key)
+		{
+			update(key);
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+	});
+
+	std::vector<std::vector<double>> samples(readers);
+	std::vector<std::thread> threads;
+	for (int r = 0; r < readers; ++r)
+	{
+		threads.emplace_back([&, r]() {
+			std::mt19937 gen(36 + r);
+			std::vector<double>& own = samples[r];
+			own.reserve(batches);
+
+			long long found = 0;
+			for (int b = 0; b < batches; ++b)
+			{
+				auto start = std::chrono::steady_clock::now();
+				for (int i = 0; i < batch; ++i)
+					found += lookup(r, static_cast<int>(gen() % keys));
+				own.push_back(std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / batch);
+			}
+			Bench::DoNotOptimize(found);
+		});
+	}
+
+	for (std::thread& thread : threads)
+		thread.join();
+	done = true;
+	writer.join();
+
+	std::vector<double> all;
+	for (const std::vector<double>& own : samples)
+		all.insert(all.end(), own.begin(), own.end());
+	return all;
+}
+
+int main()
+{
+	Tree::AVLTree<int> initial;
+	for (int key = 0; key < keys; ++key)
+		initial.insert(key);
+
+	unsigned int cores = std::thread::hardware_concurrency();
+	for (int readers : { 1, 4, static_cast<int>(cores < 8 ? 8 : cores) })
+	{
+		Tree::AVLTree<int> locked_tree(initial);
+		std::mutex lock;
+		std::vector<double> mutex = Run(readers,
+			[&](int, int key) { std::lock_guard<std::mutex> guard(lock); return locked_tree.find(key) != nullptr; },
+			[&](int key) { std::lock_guard<std::mutex> guard(lock); locked_tree.insert(key); locked_tree.erase(key - keys); });
+
+		Tree::LeftRightAVLTree<int> left_right(initial);
+		std::vector<Tree::LeftRightAVLTree<int>::Reader*> handles;
+		for (int r = 0; r < readers; ++r)
+			handles.push_back(&left_right.reader());
+		std::vector<double> wait_free = Run(readers,
+			[&](int r, int key) { return left_right.contains(*handles[r], key); },
+			[&](int key) { left_right.write([key](Tree::AVLTree<int>& tree) { tree.insert(key); tree.erase(key - keys); }); });
+
+		std::string threads = std::to_string(readers) + " readers ";
+		Bench::ReportPercentiles(threads + "std::mutex + find()", mutex);
+		Bench::ReportPercentiles(threads + "LeftRightAVLTree contains()", wait_free);
+	}
+}
@@ -0,0 +1,39 @@
+#include "AVLTree.hpp"
+#include "Bench.hpp"
+#include <random>
+#include <string>
+#include <vector>
+
+// clear() + reload cycles ("one market session" each): delete / new every node vs reuse_nodes() + reserve()
+int main()
+{
+	const int count = 60000, sessions = 20;
+	std::mt19937 gen(47);
+
+	std::vector<int> keys;
+	for (int i = 0; i < count; ++i)
+		keys.push_back(static_cast<int>(gen()));
+
+	auto cycles = [&](Tree::AVLTree<int>& tree) {
+		return Bench::Measure([&]() {
+			for (int session = 0; session < sessions; ++session)
+			{
+				for (int key : keys)
+					tree.insert(key);
+				Bench::DoNotOptimize(tree.size());
+				tree.clear();
+			}
+		});
+	};
+
+	Tree::AVLTree<int> plain;
+	double deleting = cycles(plain);
+
+	Tree::AVLTree<int> reusing;
+	reusing.reserve(count);
+	double reused = cycles(reusing);
+
+	Bench::Report("clear() + reload, new / delete", static_cast<double>(count) * sessions, deleting);
+	Bench::Report("clear() + reload, reuse_nodes() + reserve()", static_cast<double>(count) * sessions, reused);
+	return 0;
+}
@@ -0,0 +1,87 @@
+#include "Bench.hpp"
+#include "QuantileWindow.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <deque>
+#include <random>
+#include <vector>
+
+// rolling p50 / p99 over the last 60000 latency samples: QuantileWindow vs copying the window
+// and nth_element on every query (the re-scan it replaces); the target is 1M samples/s
+int main()
+{
+	const std::size_t window_size = 60000, samples = 2000000;
+	std::mt19937 gen(49);
+	std::lognormal_distribution<double> latency(4.0, 0.8); // microseconds, long tail, many repeats once rounded
+
+	std::vector<int> stream(samples);
+	for (int& sample : stream)
+		sample = static_cast<int>(latency(gen));
+
+	double push_only = Bench::Measure([&]() {
+		Tree::QuantileWindow<int> window(window_size);
+		for (int sample : stream)
+			window.push(sample);
+		Bench::DoNotOptimize(window.size());
+	});
+
+	// p50 + p99 after every sample
+	double every_sample = Bench::Measure([&]() {
+		Tree::QuantileWindow<int> window(window_size);
+		long long sum = 0;
+		for (int sample : stream)
+		{
+			window.push(sample);
+			sum += window.quantile(0.5) + window.quantile(0.99);
+		}
+		Bench::DoNotOptimize(sum);
+	});
+
+	// p50 + p99 + top 10 every 1000 samples, both ways
+	const std::size_t every = 1000;
+	double windowed = Bench::Measure([&]() {
+		Tree::QuantileWindow<int> window(window_size);
+		std::vector<int> top;
+		long long sum = 0;
+		for (std::size_t i = 0; i < samples; ++i)
+		{
+			window.push(stream[i]);
+			if (i % every == 0)
+			{
+				window.top_k(10, top);
+				sum += window.quantile(0.5) + window.quantile(0.99) + top[0];
+			}
+		}
+		Bench::DoNotOptimize(sum);
+	}, 1);
+
+	double rescan = Bench::Measure([&]() {
+		std::deque<int> window;
+		std::vector<int> copy;
+		long long sum = 0;
+		for (std::size_t i = 0; i < samples; ++i)
+		{
+			window.push_back(stream[i]);
+			if (window.size() > window_size)
+				window.pop_front();
+			if (i % every == 0)
+			{
+				copy.assign(window.begin(), window.end());
+				std::nth_element(copy.begin(), copy.begin() + (copy.size() - 1) / 2, copy.end());
+				sum += copy[(copy.size() - 1) / 2];
+				std::nth_element(copy.begin(), copy.begin() + (copy.size() - 1) * 99 / 100, copy.end());
+				sum += copy[(copy.size() - 1) * 99 / 100];
+				std::partial_sort(copy.begin(), copy.begin() + std::min<std::size_t>(10, copy.size()), copy.end(), [](int a, int b) { return a > b; });
+				sum += copy[0];
+			}
+		}
+		Bench::DoNotOptimize(sum);
+	}, 1);
+
+	Bench::Report("QuantileWindow push", static_cast<double>(samples), push_only);
+	Bench::Report("QuantileWindow push + p50 + p99 per sample", static_cast<double>(samples), every_sample);
+	Bench::Report("QuantileWindow, p50/p99/top-10 every 1000", static_cast<double>(samples), windowed);
+	Bench::Report("deque + nth_element, every 1000", static_cast<double>(samples), rescan);
+	std::printf("1M samples/s with a query per sample: %s\n", samples / every_sample >= 1e6 ? "yes" : "no");
+	return 0;
+}
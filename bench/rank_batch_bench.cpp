@@ -0,0 +1,78 @@
+#include "AVLTree.hpp"
+#include "Bench.hpp"
+#include <algorithm>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+// looped distance() vs distance_batch() / rank_batch() over sorted and random query lists
+int main()
+{
+	const int keys = 60000;
+	std::mt19937 gen(42);
+
+	Tree::AVLTree<int> tree;
+	std::vector<int> present;
+	for (int i = 0; i < keys; ++i)
+	{
+		tree.insert(i * 2);
+		present.push_back(i * 2);
+	}
+
+	for (std::size_t count : {1000, 30000, 300000})
+	{
+		std::vector<std::pair<int, int>> sorted_pairs, random_pairs;
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			int a = present[gen() % keys], b = present[gen() % keys];
+			random_pairs.emplace_back(std::min(a, b), std::max(a, b));
+		}
+		sorted_pairs = random_pairs;
+		std::sort(sorted_pairs.begin(), sorted_pairs.end());
+
+		const std::string suffix = " (" + std::to_string(count) + " pairs)";
+		for (int sorted = 1; sorted >= 0; --sorted)
+		{
+			const std::vector<std::pair<int, int>>& pairs = sorted ? sorted_pairs : random_pairs;
+			const std::string order = sorted ? "sorted" : "random";
+
+			double looped = Bench::Measure([&]() {
+				unsigned long long sum = 0;
+				for (const std::pair<int, int>& pair : pairs)
+					sum += tree.distance(pair.first, pair.second);
+				Bench::DoNotOptimize(sum);
+			});
+
+			std::vector<unsigned int> out;
+			double batched = Bench::Measure([&]() {
+				tree.distance_batch(pairs, out);
+				Bench::DoNotOptimize(out.data());
+			});
+
+			Bench::Report("distance() loop, " + order + suffix, static_cast<double>(count), looped);
+			Bench::Report("distance_batch(), " + order + suffix, static_cast<double>(count), batched);
+		}
+
+		// rank of every key: distance from the smallest element (a present key) vs one rank_batch()
+		std::vector<int> sorted_keys;
+		for (const std::pair<int, int>& pair : sorted_pairs)
+			sorted_keys.push_back(pair.first);
+
+		double looped = Bench::Measure([&]() {
+			unsigned long long sum = 0;
+			for (int key : sorted_keys)
+				sum += tree.distance(0, key);
+			Bench::DoNotOptimize(sum);
+		});
+
+		std::vector<std::size_t> ranks;
+		double batched = Bench::Measure([&]() {
+			tree.rank_batch(sorted_keys, ranks);
+			Bench::DoNotOptimize(ranks.data());
+		});
+
+		Bench::Report("distance(min, key) loop" + suffix, static_cast<double>(count), looped);
+		Bench::Report("rank_batch(), sorted" + suffix, static_cast<double>(count), batched);
+	}
+}
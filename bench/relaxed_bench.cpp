@@ -0,0 +1,39 @@
+#include "AVLTree.hpp"
+#include "RelaxedAVLTree.hpp"
+#include "Bench.hpp"
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <vector>
+
+// write burst of keys, then one read pass over the same keys
+template<typename Tree_t>
+static double BurstThenRead(const std::vector<int>& keys)
+{
+	return Bench::Measure([&]() {
+		Tree_t tree;
+		for (int key : keys)
+			tree.insert(key);
+
+		std::size_t found = 0;
+		for (int key : keys)
+			found += tree.find(key) != nullptr;
+		Bench::DoNotOptimize(found);
+	});
+}
+
+int main()
+{
+	const std::size_t count = 60000;
+	std::mt19937 gen(30);
+
+	std::vector<int> ascending(count);
+	std::iota(ascending.begin(), ascending.end(), 0);
+	std::vector<int> random = ascending;
+	std::shuffle(random.begin(), random.end(), gen);
+
+	Bench::Report("random burst+read AVLTree", 2.0 * count, BurstThenRead<Tree::AVLTree<int>>(random));
+	Bench::Report("random burst+read RelaxedAVLTree", 2.0 * count, BurstThenRead<Tree::RelaxedAVLTree<int>>(random));
+	Bench::Report("ascending burst+read AVLTree", 2.0 * count, BurstThenRead<Tree::AVLTree<int>>(ascending));
+	Bench::Report("ascending burst+read RelaxedAVLTree", 2.0 * count, BurstThenRead<Tree::RelaxedAVLTree<int>>(ascending));
+}
@@ -0,0 +1,65 @@
+#include "AVLTree.hpp"
+#include "Bench.hpp"
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+// Same Key Behind A Class: not arithmetic, so the tree takes the generic (recursive, three-compare) path
+template<typename T>
+struct Boxed
+{
+	T value;
+
+	Boxed(T value) : value(value) { }
+	bool operator<(const Boxed& other) const { return value < other.value; }
+	bool operator>(const Boxed& other) const { return value > other.value; }
+	bool operator==(const Boxed& other) const { return value == other.value; }
+	bool operator!=(const Boxed& other) const { return value != other.value; }
+};
+
+template<typename Key, typename Source>
+static void Run(const std::string& name, const std::vector<Source>& keys)
+{
+	const double count = static_cast<double>(keys.size());
+
+	double insert = Bench::Measure([&]() {
+		Tree::AVLTree<Key> tree;
+		for (const Source& key : keys)
+			tree.insert(Key(key));
+		Bench::DoNotOptimize(tree.size());
+	});
+
+	Tree::AVLTree<Key> tree;
+	for (const Source& key : keys)
+		tree.insert(Key(key));
+
+	double find = Bench::Measure([&]() {
+		std::size_t found = 0;
+		for (const Source& key : keys)
+			found += tree.find(Key(key)) != nullptr;
+		Bench::DoNotOptimize(found);
+	});
+
+	Bench::Report(name + " insert()", count, insert);
+	Bench::Report(name + " find()", count, find);
+}
+
+int main()
+{
+	const int count = 60000;
+	std::mt19937_64 gen(37);
+
+	std::vector<int> ints(count);
+	std::vector<std::uint64_t> wide(count);
+	for (int i = 0; i < count; ++i)
+	{
+		wide[i] = gen();
+		ints[i] = static_cast<int>(wide[i] >> 32);
+	}
+
+	Run<int>("int (arithmetic path)", ints);
+	Run<Boxed<int>>("Boxed<int> (generic path)", ints);
+	Run<std::uint64_t>("uint64_t (arithmetic path)", wide);
+	Run<Boxed<std::uint64_t>>("Boxed<uint64_t> (generic path)", wide);
+}
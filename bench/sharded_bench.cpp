@@ -0,0 +1,70 @@
+#include "AVLTree.hpp"
+#include "ShardedAVLTree.hpp"
+#include "Bench.hpp"
+#include <algorithm>
+#include <mutex>
+#include <numeric>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+// distinct random keys, threads insert disjoint slices of them at the same time
+static const int keys = 60000;
+
+template<typename Insert>
+static double Run(int threads, const std::vector<int>& order, Insert insert)
+{
+	auto start = std::chrono::steady_clock::now();
+	std::vector<std::thread> workers;
+	for (int t = 0; t < threads; ++t)
+	{
+		workers.emplace_back([&, t]() {
+			for (std::size_t i = t; i < order.size(); i += threads)
+				insert(order[i]);
+		});
+	}
+	for (std::thread& worker : workers)
+		worker.join();
+
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main()
+{
+	std::vector<int> order(keys);
+	std::iota(order.begin(), order.end(), 0);
+	std::shuffle(order.begin(), order.end(), std::mt19937(41));
+
+	std::vector<int> bounds;
+	for (int i = 1; i < 64; ++i)
+		bounds.push_back(keys / 64 * i);
+
+	std::printf("hardware threads: %u\n", std::thread::hardware_concurrency());
+	for (int threads : {1, 2, 4, 8, 16, 32, 64})
+	{
+		const std::string suffix = " x" + std::to_string(threads);
+
+		double locked = Bench::Measure([&]() {
+			Tree::AVLTree<int> tree;
+			std::mutex lock;
+			Run(threads, order, [&](int key) {
+				std::lock_guard<std::mutex> guard(lock);
+				tree.insert(key);
+			});
+		});
+		Bench::Report("std::mutex + AVLTree" + suffix, keys, locked);
+
+		double sharded = Bench::Measure([&]() {
+			Tree::ShardedAVLTree<int> tree;
+			Run(threads, order, [&](int key) { tree.insert(key); });
+		});
+		Bench::Report("ShardedAVLTree (auto split)" + suffix, keys, sharded);
+
+		double preset = Bench::Measure([&]() {
+			Tree::ShardedAVLTree<int> tree(bounds);
+			Run(threads, order, [&](int key) { tree.insert(key); });
+		});
+		Bench::Report("ShardedAVLTree (64 preset shards)" + suffix, keys, preset);
+	}
+}
@@ -0,0 +1,75 @@
+#include "AVLTree.hpp"
+#include "StringAVLTree.hpp"
+#include "Bench.hpp"
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+// URL-style: long shared prefix, difference in the tail
+static std::vector<std::string> UrlKeys(std::size_t count, std::mt19937& gen)
+{
+	std::vector<std::string> keys;
+	for (std::size_t i = 0; i < count; ++i)
+		keys.push_back("https://cdn.example.com/static/assets/" + std::to_string(gen() % 100) + "/item-" + std::to_string(gen()));
+	return keys;
+}
+
+// UUID-style: random hex, difference in the first bytes
+static std::vector<std::string> UuidKeys(std::size_t count, std::mt19937& gen)
+{
+	static const char hex[] = "0123456789abcdef";
+	std::vector<std::string> keys;
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		std::string key(36, '-');
+		for (std::size_t c = 0; c < key.size(); ++c)
+			if (c != 8 && c != 13 && c != 18 && c != 23)
+				key[c] = hex[gen() % 16];
+		keys.push_back(key);
+	}
+	return keys;
+}
+
+template<typename Tree_t>
+static void Run(const std::string& name, const std::vector<std::string>& keys, const std::vector<std::string>& probes)
+{
+	double insert = Bench::Measure([&]() {
+		Tree_t tree;
+		for (const std::string& key : keys)
+			tree.insert(key);
+		Bench::DoNotOptimize(tree.size());
+	});
+
+	Tree_t tree;
+	for (const std::string& key : keys)
+		tree.insert(key);
+
+	double find = Bench::Measure([&]() {
+		std::size_t found = 0;
+		for (const std::string& key : probes)
+			found += tree.find(key) != nullptr;
+		Bench::DoNotOptimize(found);
+	});
+
+	Bench::Report(name + " insert", keys.size(), insert);
+	Bench::Report(name + " find", probes.size(), find);
+}
+
+int main()
+{
+	const std::size_t count = 60000;
+	std::mt19937 gen(27);
+
+	std::vector<std::string> sets[] = {UrlKeys(count, gen), UuidKeys(count, gen)};
+	const char* names[] = {"url", "uuid"};
+
+	for (int i = 0; i < 2; ++i)
+	{
+		std::vector<std::string> probes = sets[i];
+		std::shuffle(probes.begin(), probes.end(), gen);
+
+		Run<Tree::AVLTree<std::string>>(std::string(names[i]) + " AVLTree<std::string>", sets[i], probes);
+		Run<Tree::StringAVLTree<>>(std::string(names[i]) + " StringAVLTree", sets[i], probes);
+	}
+}
@@ -0,0 +1,93 @@
+#include "AVLTree.hpp"
+#include "Bench.hpp"
+#include "Reclaimer.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+// teardown of many full trees, as seen by the calling thread: the longest pause of clear(),
+// of clear_step(budget) calls, and of detach() + Reclaimer::retire()
+// (a tree holds at most 65535 elements, so ~4M nodes are spread over 64 trees of 60000, not one large tree)
+namespace
+{
+	const int trees = 64, per_tree = 60000;
+
+	std::vector<Tree::AVLTree<int>> Forest(unsigned int seed)
+	{
+		std::mt19937 gen(seed);
+		std::vector<Tree::AVLTree<int>> forest(trees);
+		for (Tree::AVLTree<int>& tree : forest)
+		{
+			for (int i = 0; i < per_tree; ++i)
+				tree.insert(static_cast<int>(gen()));
+		}
+		return forest;
+	}
+
+	double Nanoseconds(std::chrono::steady_clock::time_point start)
+	{
+		return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+	}
+
+	void Line(const std::string& name, const std::vector<double>& pauses, double total)
+	{
+		Bench::ReportPercentiles(name + " pauses", pauses);
+		std::printf("%-44s max %10.1f us, %8.1f ms on the caller\n", "", *std::max_element(pauses.begin(), pauses.end()) / 1e3, total / 1e6);
+	}
+}
+
+int main()
+{
+	{
+		std::vector<Tree::AVLTree<int>> forest = Forest(1);
+		std::vector<double> pauses;
+		double total = 0;
+		for (Tree::AVLTree<int>& tree : forest)
+		{
+			auto start = std::chrono::steady_clock::now();
+			tree.clear();
+			pauses.push_back(Nanoseconds(start));
+			total += pauses.back();
+		}
+		Line("clear()", pauses, total);
+	}
+
+	for (std::size_t budget : { 256, 4096 })
+	{
+		std::vector<Tree::AVLTree<int>> forest = Forest(2);
+		std::vector<double> pauses;
+		double total = 0;
+		for (Tree::AVLTree<int>& tree : forest)
+		{
+			for (bool done = false; !done;)
+			{
+				auto start = std::chrono::steady_clock::now();
+				done = tree.clear_step(budget);
+				pauses.push_back(Nanoseconds(start));
+				total += pauses.back();
+			}
+		}
+		Line("clear_step(" + std::to_string(budget) + ")", pauses, total);
+	}
+
+	{
+		std::vector<Tree::AVLTree<int>> forest = Forest(3);
+		std::vector<double> pauses;
+		double total = 0;
+		Tree::Reclaimer reclaimer;
+		for (Tree::AVLTree<int>& tree : forest)
+		{
+			auto start = std::chrono::steady_clock::now();
+			reclaimer.retire(tree.detach());
+			pauses.push_back(Nanoseconds(start));
+			total += pauses.back();
+		}
+		Line("detach() + Reclaimer::retire()", pauses, total);
+		reclaimer.drain();
+	}
+
+	return 0;
+}
@@ -0,0 +1,97 @@
+#include "AVLTree.hpp"
+#include "Bench.hpp"
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <set>
+#include <vector>
+
+// Perf Gate: replay one operation trace (insert / erase / find, 3 bytes per step as in tests/Differential.hpp)
+// on AVLTree<int> and std::set<int>; exit 1 when AVLTree throughput falls under min_ratio x std::set.
+// usage: traceReplayBench [min_ratio] [trace file]   (no file: a fixed-seed trace of 300000 steps)
+
+struct Step
+{
+	std::uint8_t op; // 0 insert, 1 erase, 2 find
+	int key;
+};
+
+static std::vector<Step> Decode(const std::vector<std::uint8_t>& bytes)
+{
+	std::vector<Step> steps;
+	for (std::size_t i = 0; i + 3 <= bytes.size(); i += 3)
+		steps.push_back(Step{ static_cast<std::uint8_t>(bytes[i] % 3), (bytes[i + 1] | (bytes[i + 2] << 8)) % 50000 });
+	return steps;
+}
+
+static std::vector<std::uint8_t> Recorded(const char* path)
+{
+	std::ifstream in(path, std::ios::binary);
+	return std::vector<std::uint8_t>(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+static std::vector<std::uint8_t> Generated()
+{
+	// grow to ~30000 keys, then mixed reads and churn
+	std::mt19937 gen(43);
+	std::vector<std::uint8_t> bytes;
+	for (int i = 0; i < 300000; ++i)
+	{
+		unsigned int pick = gen() % 10;
+		std::uint8_t op = i < 60000 ? 0 : pick < 6 ? 2 : pick < 8 ? 0 : 1;
+		int key = static_cast<int>(gen() % 50000);
+		bytes.push_back(op);
+		bytes.push_back(static_cast<std::uint8_t>(key & 0xff));
+		bytes.push_back(static_cast<std::uint8_t>(key >> 8));
+	}
+	return bytes;
+}
+
+template<typename Set, typename Contains>
+static double Replay(const std::vector<Step>& steps, Contains contains)
+{
+	return Bench::Measure([&]() {
+		Set set;
+		std::size_t found = 0;
+		for (const Step& step : steps)
+		{
+			if (step.op == 0)
+				set.insert(step.key);
+			else if (step.op == 1)
+				set.erase(step.key);
+			else
+				found += contains(set, step.key);
+		}
+		Bench::DoNotOptimize(found);
+	}, 5);
+}
+
+int main(int argc, char** argv)
+{
+	const double min_ratio = argc > 1 ? std::atof(argv[1]) : 0.0;
+	const std::vector<Step> steps = Decode(argc > 2 ? Recorded(argv[2]) : Generated());
+	if (steps.empty())
+	{
+		std::fprintf(stderr, "empty trace\n");
+		return 1;
+	}
+
+	double tree = Replay<Tree::AVLTree<int>>(steps, [](const Tree::AVLTree<int>& set, int key) { return set.find(key) != nullptr; });
+	double reference = Replay<std::set<int>>(steps, [](const std::set<int>& set, int key) { return set.count(key) != 0; });
+
+	Bench::Report("trace replay AVLTree", static_cast<double>(steps.size()), tree);
+	Bench::Report("trace replay std::set", static_cast<double>(steps.size()), reference);
+
+	const double ratio = reference / tree;
+	std::printf("AVLTree / std::set throughput: %.2f (gate: %.2f)\n", ratio, min_ratio);
+	if (ratio < min_ratio)
+	{
+		std::fprintf(stderr, "perf gate failed: AVLTree replays the trace at %.2f x std::set, below %.2f\n", ratio, min_ratio);
+		return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,17 @@
+#include "Differential.hpp"
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+
+// libFuzzer entry: every input is an operation trace, replayed on AVLTree<int> and std::set<int>
+extern "C" int LLVMFuzzerTestOneInput(const std::uint8_t* data, std::size_t size)
+{
+	std::string error = Differential::Replay(data, size);
+	if (!error.empty())
+	{
+		std::fprintf(stderr, "AVLTree differs from std::set: %s\n", error.c_str());
+		std::abort();
+	}
+
+	return 0;
+}
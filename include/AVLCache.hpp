@@ -0,0 +1,258 @@
+#pragma once
+#include "AVLTree.hpp"
+#include <chrono>
+#include <stdexcept>
+
+namespace Tree
+{
+	// Node Augmentation: intrusive recency list + insertion (expiry) list + parent link
+	template<typename Clock>
+	struct CacheAugment : NoAugment
+	{
+		CacheAugment* parent = nullptr; // stale on the root (a walk up stops at the tree's root)
+		mutable CacheAugment* lru_prev = this;
+		mutable CacheAugment* lru_next = this;
+		CacheAugment* ttl_prev = this;
+		CacheAugment* ttl_next = this;
+		typename Clock::time_point expires = Clock::time_point::max();
+
+		// Link Self Right After head (both lists are circular around a sentinel)
+		void link_lru(CacheAugment* head) const
+		{
+			lru_prev = head;
+			lru_next = head->lru_next;
+			head->lru_next->lru_prev = const_cast<CacheAugment*>(this);
+			head->lru_next = const_cast<CacheAugment*>(this);
+		}
+
+		void unlink_lru() const
+		{
+			lru_prev->lru_next = lru_next;
+			lru_next->lru_prev = lru_prev;
+		}
+
+		// Children Of root Changed Or Were Rebalanced: point them back at it
+		template<typename Node>
+		static void update(Node* root)
+		{
+			if (root->left)
+				root->left->parent = root;
+			if (root->right)
+				root->right->parent = root;
+		}
+
+		// Called Before erase() Deletes The Node
+		template<typename Node>
+		static void unlink(Node* root)
+		{
+			root->unlink_lru();
+			root->ttl_prev->ttl_next = root->ttl_next;
+			root->ttl_next->ttl_prev = root->ttl_prev;
+		}
+	};
+
+	// Ordered Cache: AVLTree with a capacity (LRU eviction) and an optional TTL
+	template<typename T, typename T_Height = unsigned char, typename Clock = std::chrono::steady_clock>
+	class AVLCache : protected AVLTree<T, T_Height, CacheAugment<Clock>>
+	{
+	private:
+		using Base = AVLTree<T, T_Height, CacheAugment<Clock>>;
+		using Augment = CacheAugment<Clock>;
+
+		Augment sentinel; // lru_next = most recent, ttl_next = oldest
+		unsigned short capacity_;
+		typename Clock::duration ttl_;
+
+	public:
+		using Node = typename Base::Node;
+		using time_point = typename Clock::time_point;
+		using duration = typename Clock::duration;
+		using iterator = typename Base::iterator;
+		using const_iterator = typename Base::const_iterator;
+
+	public: // Constructors
+		// ttl == duration::zero(): entries never expire (throws std::invalid_argument if capacity == 0)
+		explicit AVLCache(unsigned short capacity, duration ttl = duration::zero())
+			: capacity_(capacity), ttl_(ttl)
+		{
+			if (capacity == 0)
+				throw std::invalid_argument("AVLCache: capacity must be at least 1");
+		}
+
+		// the lists point at sentinel, so the cache stays where it was built
+		AVLCache(const AVLCache&) = delete;
+		AVLCache& operator=(const AVLCache&) = delete;
+
+	public: // Methods
+		// Insert As Most Recent, Evict The Least Recent Past capacity
+		// (duplicate: touch only; expired duplicate: renewed like a new entry, returns true)
+		bool insert(const T& data, time_point now);
+		bool insert(const T& data);
+
+		bool erase(const T& data);
+
+		// Find + Mark As Most Recent (expired entries are not found)
+		const Node* find(const T& data, time_point now);
+		const Node* find(const T& data);
+
+		// Remove Every Entry Expired At now, Oldest First. Expired entries are only removed here and
+		// by eviction: until then size() counts them, although find() no longer returns them
+		unsigned int expire(time_point now = Clock::now());
+
+		// Least Recently Used Entry (nullptr if empty)
+		const Node* lru() const;
+
+		void clear();
+		unsigned short capacity() const;
+		using Base::size;
+		using Base::distance;
+		using Base::begin;
+		using Base::end;
+		using Base::cbegin;
+		using Base::cend;
+		using Base::check_invariants;
+
+	private:
+		// Append node To The Expiry List (newest) With Expiry now + ttl
+		void LinkTtl(Node* node, time_point now);
+
+		// Erase node Through Its Parent Links: no key lookup
+		void Evict(Node* node);
+
+		// Current Time, Clock Is Not Read Without A TTL
+		time_point current_time() const;
+	};
+
+	//
+	// Private Methods
+	//
+
+	template<typename T, typename T_Height, typename Clock>
+	inline void AVLCache<T, T_Height, Clock>::LinkTtl(Node* node, time_point now)
+	{
+		node->ttl_prev = sentinel.ttl_prev;
+		node->ttl_next = &sentinel;
+		sentinel.ttl_prev->ttl_next = node;
+		sentinel.ttl_prev = node;
+		if (ttl_ != duration::zero())
+			node->expires = now + ttl_;
+	}
+
+	template<typename T, typename T_Height, typename Clock>
+	inline void AVLCache<T, T_Height, Clock>::Evict(Node* node)
+	{
+		Node* path[Base::max_depth];
+		std::size_t depth = Base::max_depth;
+		for (path[--depth] = node; node != this->root; path[--depth] = node)
+			node = static_cast<Node*>(node->parent);
+
+		Base::EraseAt(path + depth, Base::max_depth - depth);
+	}
+
+	template<typename T, typename T_Height, typename Clock>
+	inline typename AVLCache<T, T_Height, Clock>::time_point AVLCache<T, T_Height, Clock>::current_time() const
+	{
+		return ttl_ == duration::zero() ? time_point::min() : Clock::now();
+	}
+
+	// _Private Methods
+
+	//
+	// Public Methods
+	//
+
+	template<typename T, typename T_Height, typename Clock>
+	inline bool AVLCache<T, T_Height, Clock>::insert(const T& data, time_point now)
+	{
+		if (!Base::insert(data))
+		{
+			Node* node = this->lastNode;
+			node->unlink_lru();
+			node->link_lru(&sentinel);
+			if (node->expires > now)
+				return false;
+
+			// expired but not swept yet: renew it as if it had been erased and inserted
+			node->ttl_prev->ttl_next = node->ttl_next;
+			node->ttl_next->ttl_prev = node->ttl_prev;
+			LinkTtl(node, now);
+			return true;
+		}
+
+		Node* node = this->lastNode;
+		node->link_lru(&sentinel);
+		LinkTtl(node, now);
+
+		if (Base::size() > capacity_)
+		{
+			Evict(static_cast<Node*>(sentinel.lru_prev));
+		}
+
+		return true;
+	}
+
+	template<typename T, typename T_Height, typename Clock>
+	inline bool AVLCache<T, T_Height, Clock>::insert(const T& data)
+	{
+		return insert(data, current_time());
+	}
+
+	template<typename T, typename T_Height, typename Clock>
+	inline bool AVLCache<T, T_Height, Clock>::erase(const T& data)
+	{
+		return Base::erase(data);
+	}
+
+	template<typename T, typename T_Height, typename Clock>
+	inline const typename AVLCache<T, T_Height, Clock>::Node* AVLCache<T, T_Height, Clock>::find(const T& data, time_point now)
+	{
+		const Node* node = Base::find(data);
+		if (node == nullptr || node->expires <= now)
+			return nullptr;
+
+		node->unlink_lru();
+		node->link_lru(&sentinel);
+		return node;
+	}
+
+	template<typename T, typename T_Height, typename Clock>
+	inline const typename AVLCache<T, T_Height, Clock>::Node* AVLCache<T, T_Height, Clock>::find(const T& data)
+	{
+		return find(data, current_time());
+	}
+
+	template<typename T, typename T_Height, typename Clock>
+	inline unsigned int AVLCache<T, T_Height, Clock>::expire(time_point now)
+	{
+		unsigned int removed = 0;
+		while (sentinel.ttl_next != &sentinel && sentinel.ttl_next->expires <= now)
+		{
+			Evict(static_cast<Node*>(sentinel.ttl_next));
+			++removed;
+		}
+
+		return removed;
+	}
+
+	template<typename T, typename T_Height, typename Clock>
+	inline const typename AVLCache<T, T_Height, Clock>::Node* AVLCache<T, T_Height, Clock>::lru() const
+	{
+		return sentinel.lru_prev == &sentinel ? nullptr : static_cast<const Node*>(sentinel.lru_prev);
+	}
+
+	template<typename T, typename T_Height, typename Clock>
+	inline void AVLCache<T, T_Height, Clock>::clear()
+	{
+		Base::clear();
+		sentinel.lru_prev = sentinel.lru_next = &sentinel;
+		sentinel.ttl_prev = sentinel.ttl_next = &sentinel;
+	}
+
+	template<typename T, typename T_Height, typename Clock>
+	inline unsigned short AVLCache<T, T_Height, Clock>::capacity() const
+	{
+		return capacity_;
+	}
+
+	// _Public Methods
+}
@@ -1,7 +1,15 @@
 #pragma once
+#include <algorithm>
 #include <initializer_list>
 #include <stdexcept> 
 #include <limits.h>
+#include <stdint.h>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 #if ((defined(_MSVC_LANG) && _MSVC_LANG >= 201703L) || __cplusplus >= 201703L)
 #define NODISCARD [[nodiscard]]
@@ -9,18 +17,181 @@
 #define NODISCARD
 #endif
 
+#if ((defined(_MSVC_LANG) && _MSVC_LANG >= 202002L) || __cplusplus >= 202002L)
+#include <compare>
+#endif
+
+// Read Hint For A Node Needed Soon (no-op where the compiler has no prefetch)
+#if defined(__GNUC__) || defined(__clang__)
+#define AVLTREE_PREFETCH(address) __builtin_prefetch(address)
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <xmmintrin.h>
+#define AVLTREE_PREFETCH(address) _mm_prefetch(reinterpret_cast<const char*>(address), _MM_HINT_T0)
+#else
+#define AVLTREE_PREFETCH(address) ((void)(address))
+#endif
+
 namespace Tree
 {
-	template<typename T, typename T_Height = unsigned char>
+	// Default Node Augmentation (nothing stored, nothing updated)
+	struct NoAugment
+	{
+		// Called After Height/Sizes Of root Are Updated
+		template<typename Node>
+		static void update(Node*) { }
+
+		// Called Before erase() Deletes The Node
+		template<typename Node>
+		static void unlink(Node*) { }
+
+		// Called Before insert() Allocates A Child Of parent (placement hint for node storage);
+		// place(nullptr) when the node comes off the free list instead, so the hint does not go stale
+		template<typename Node>
+		static void place(const Node*) { }
+
+		// Called After Each Rotation, root Is The New Subtree Root (a double rotation is one call)
+		template<typename Node>
+		static void rotate(const Node*) { }
+	};
+
+	// Balancing Of Any Node With left, right, height, size_r, size_l (AVLTree::Node, AVLHook, ...)
+	template<typename Node, typename T_Height, typename Augment = NoAugment>
+	class AVLBalance
+	{
+	public:
+		// Get Minimal Element
+		static Node* GetMinElement(Node* root);
+
+		// Get The Correct Height
+		static T_Height height(const Node* root);
+
+		// Update Height + Sizes + Augmentation
+		static void update(Node* root);
+
+		// Get Balance Factor
+		static signed char balance_factor(const Node* root);
+
+		// Balance Root + Update Height
+		static Node* balance(Node* root);
+
+		// Unlink Minimal Element (not deleted) + Balance Tree
+		static Node* RemBalMin(Node* root, Node* minroot);
+
+		// Update After A Rebuild From Sorted Nodes (children done)
+		static void build(Node* root);
+
+		// Balance Rule Of root Holds (children checked before)
+		static bool valid(const Node* root);
+
+	private:
+		static unsigned char abs(signed char element);
+
+		// Balancing
+
+		// Single Left Rotation
+		static void SingleLeftRotation(Node*& root);
+
+		// Double Left Roration
+		static void DoubleLeftRotation(Node*& root);
+
+		// Single Right Rotation
+		static void SingleRightRotation(Node*& root);
+
+		// Double Right Roration
+		static void DoubleRightRotation(Node*& root);
+
+		// _Balancing
+	};
+
+	// WAVL (Weak AVL) Balancing: height holds a rank, rank differences are 1 or 2 and leaves have rank 1.
+	// Same heights as AVL after inserts only; erases never rotate more than twice and are amortized O(1)
+	template<typename Node, typename T_Height, typename Augment = NoAugment>
+	class WAVLBalance
+	{
+	public:
+		static Node* GetMinElement(Node* root);
+
+		// Rank (0 for nullptr)
+		static T_Height height(const Node* root);
+
+		// Update Sizes + Augmentation (the rank only changes by promote / demote)
+		static void update(Node* root);
+
+		// Fix The Rank Rule At root: a 0-child (insert), a 3-child or a 2,2 leaf (erase)
+		static Node* balance(Node* root);
+
+		static Node* RemBalMin(Node* root, Node* minroot);
+
+		// A Balanced Rebuild Is An AVL Tree: rank = height
+		static void build(Node* root);
+
+		static bool valid(const Node* root);
+
+	private:
+		// Rotations Keep The Ranks (balance() sets them)
+		static Node* RotateLeft(Node* root);
+		static Node* RotateRight(Node* root);
+	};
+
+	// Weight Balancing (BB[alpha], Delta = 3, Gamma = 2 on weights size + 1): uses only size_l / size_r,
+	// height is not maintained. Height <= log_4/3(n), rotations are amortized O(1) per update
+	template<typename Node, typename T_Height, typename Augment = NoAugment>
+	class WeightBalance
+	{
+	public:
+		static constexpr std::size_t delta = 3, gamma = 2;
+
+		static Node* GetMinElement(Node* root);
+
+		// Update Sizes + Augmentation
+		static void update(Node* root);
+
+		// Rotate At root When One Side Weighs More Than delta Times The Other
+		static Node* balance(Node* root);
+
+		static Node* RemBalMin(Node* root, Node* minroot);
+
+		static void build(Node* root);
+
+		static bool valid(const Node* root);
+
+	private:
+		static std::size_t weight(const Node* root);
+
+		static Node* RotateLeft(Node* root);
+		static Node* RotateRight(Node* root);
+	};
+
+	// Balancing Policies Of AVLTree: Tree::AVLTree<T, T_Height, Augment, Tree::WAVLBalancing>
+	struct AVLBalancing
+	{
+		template<typename Node, typename T_Height, typename Augment>
+		using type = AVLBalance<Node, T_Height, Augment>;
+	};
+
+	struct WAVLBalancing
+	{
+		template<typename Node, typename T_Height, typename Augment>
+		using type = WAVLBalance<Node, T_Height, Augment>;
+	};
+
+	struct WeightBalancing
+	{
+		template<typename Node, typename T_Height, typename Augment>
+		using type = WeightBalance<Node, T_Height, Augment>;
+	};
+
+	template<typename T, typename T_Height = unsigned char, typename Augment = NoAugment, typename Balancing = AVLBalancing>
 	class AVLTree
 	{
 	public: // Node
-		class Node
+		class Node : public Augment
 		{
 		public:
 			T data;
 		private:
-			Node(T data = T(), Node* right = nullptr, Node* left = nullptr) : data(data), right(right), left(left), height(1), size_r(0), size_l(0) {}
+			explicit Node(const T& data) : data(data), left(nullptr), right(nullptr), height(1), size_r(0), size_l(0) { Augment::update(this); }
+			explicit Node(T&& data) : data(std::move(data)), left(nullptr), right(nullptr), height(1), size_r(0), size_l(0) { Augment::update(this); }
 
 			Node* left;
 			Node* right;
@@ -28,12 +199,65 @@ namespace Tree
 			unsigned short size_r, size_l;
 
 			friend class AVLTree;
+			friend class AVLBalance<Node, T_Height, Augment>;
+			friend class WAVLBalance<Node, T_Height, Augment>;
+			friend class WeightBalance<Node, T_Height, Augment>;
+			friend Augment;
 		};
 
 	private:
+		using Balance = typename Balancing::template type<Node, T_Height, Augment>;
+
+	protected:
 		Node* root;
+		Node* lastNode = nullptr; // created or matched by the last insert
+		static constexpr std::size_t max_depth = 64; // 2^16 nodes: AVL height < 24, WAVL < 33, weight-balanced < 40
+
+	private:
 		mutable bool isSuccessfully = true;
 		unsigned short size_ = 0;
+		std::size_t version_ = 0; // bumped by every change of shape, older fingers restart from root
+
+		// compact(): contiguous node blocks + the breadth-first pass in progress
+		struct Layout
+		{
+			struct Block
+			{
+				Node* nodes;
+				std::size_t capacity, used = 0, live = 0;
+
+				bool owns(const Node* node) const { return node >= nodes && node < nodes + capacity; }
+			};
+
+			// child link of owner (nullptr: root), owner is a node already moved into the target block
+			struct Link
+			{
+				Node* owner;
+				bool right;
+			};
+
+			std::vector<Block> blocks; // blocks.back() is the target of an active pass
+			std::vector<Link> queue;   // breadth-first, queue[head] is next
+			std::size_t head = 0;
+			std::vector<bool> dead;    // target slots erased during the pass (their links are skipped)
+			bool active = false;
+
+			~Layout()
+			{
+				for (Block& block : blocks)
+					::operator delete(block.nodes);
+			}
+		};
+
+		std::unique_ptr<Layout> layout_; // nullptr until the first compact()
+
+		// reuse_nodes(): erased / cleared nodes wait here (linked by right, data kept) for the next insert
+		Node* free_ = nullptr;
+		std::size_t free_count_ = 0;
+		bool reuse_ = false;
+
+		// clear_step(): nodes of the pass in progress, still linked as a tree (flattened by rotations while freed)
+		Node* graveyard_ = nullptr;
 
 		enum class ittype
 		{
@@ -85,6 +309,133 @@ namespace Tree
 			const T* operator->() const;
 		};
 		// _iterators
+
+		//
+		// cursor: non-throwing iterator, {root, path from root to node}, end() = {root, empty path}
+		//
+		class Cursor
+		{
+		private:
+			const Node* root = nullptr;
+			const Node* path[max_depth]; // path[depth - 1] = current node
+			std::size_t depth = 0;
+
+			const Node* current() const noexcept { return depth ? path[depth - 1] : nullptr; }
+
+			// Push node And Its Leftmost (left == true) Or Rightmost Descendants
+			void Descend(const Node* node, bool left) noexcept;
+
+		public:
+			using value_type = T;
+			using difference_type = std::ptrdiff_t;
+			using pointer = const T*;
+			using reference = const T&;
+#if ((defined(_MSVC_LANG) && _MSVC_LANG >= 202002L) || __cplusplus >= 202002L)
+			using iterator_concept = std::bidirectional_iterator_tag;
+#endif
+			using iterator_category = std::bidirectional_iterator_tag;
+
+			Cursor() = default;
+			// One Descent From root To current (nullptr: end())
+			Cursor(const Node* current, const Node* root) noexcept;
+
+			const T& operator*() const noexcept { return current()->data; }
+			const T* operator->() const noexcept { return &current()->data; }
+
+			// Successor: right subtree or pop the path, amortized O(1) (no allocation, no throw)
+			Cursor& operator++() noexcept;
+			Cursor operator++(int) noexcept;
+
+			// Predecessor, from end(): maximal element
+			Cursor& operator--() noexcept;
+			Cursor operator--(int) noexcept;
+
+			bool operator==(const Cursor& other) const noexcept { return current() == other.current(); }
+			bool operator!=(const Cursor& other) const noexcept { return current() != other.current(); }
+		};
+
+		//
+		// View: [first, last) of any tree iterator + its size (from the subtree counts)
+		//
+		template<typename It>
+		class View
+		{
+		private:
+			It first, last;
+			std::size_t count = 0;
+
+		public:
+			View() = default;
+			View(It first, It last, std::size_t count) : first(first), last(last), count(count) { }
+
+			It begin() const { return first; }
+			It end() const { return last; }
+			std::size_t size() const { return count; }
+			bool empty() const { return count == 0; }
+		};
+
+		//
+		// finger: remembered root-to-node path, find_from()/insert_near() climb it instead of starting at root
+		//
+		class Finger
+		{
+		private:
+			static constexpr std::size_t none = static_cast<std::size_t>(-1);
+
+			// lo/hi: path index of the nearest ancestor bounding the subtree from below/above (none = unbounded)
+			struct Step
+			{
+				Node* node;
+				std::size_t lo, hi;
+			};
+
+			std::vector<Step> path; // path.front() = root, path.back() = node of the last operation
+			const AVLTree* owner = nullptr;
+			std::size_t version = 0; // owner->version_ when path was taken
+
+			void push(Node* child, bool right)
+			{
+				const std::size_t parent = path.size() - 1;
+				const Step step = { child, right ? parent : path.back().lo, right ? path.back().hi : parent };
+				path.push_back(step);
+			}
+
+			friend class AVLTree;
+
+		public:
+			Finger() = default;
+
+			// Node Of The Last find_from()/insert_near(): the match, or the parent of the missing key
+			const Node* get() const noexcept { return path.empty() ? nullptr : path.back().node; }
+		};
+
+		// In-Order Walk With An Explicit Stack (no root walks, for whole-tree passes)
+		class InOrder
+		{
+		private:
+			std::vector<const Node*> path;
+
+			void PushLeft(const Node* root)
+			{
+				for (; root; root = root->left)
+					path.push_back(root);
+			}
+
+		public:
+			explicit InOrder(const Node* root) { PushLeft(root); }
+
+			// Next Node (nullptr after the last one)
+			const Node* next()
+			{
+				if (path.empty())
+					return nullptr;
+
+				const Node* current = path.back();
+				path.pop_back();
+				PushLeft(current->right);
+				return current;
+			}
+		};
 		
 		
 		// Methods
@@ -109,48 +460,26 @@ namespace Tree
 
 		// _static Methods
 
-		unsigned char abs(signed char element) const;
-
-		// Balancing
-
-
-		// Single Left Rotation
-		void SingleLeftRotation(Node*& root);
-
-		// Double Left Roration
-		void DoubleLeftRotation(Node*& root);
-
-		// Single Right Rotation
-		void SingleRightRotation(Node*& root);
-
-		// Double Right Roration
-		void DoubleRightRotation(Node*& root);
-
-		// _Balancing
-
-		// Compare 2 AVLTrees
-		void IsEqual(const Node* myRoot, const Node* other) const;
-
 		// Remove All Elements (NEED THAT SIZE > 0)
 		Node* RemoveAllNode(Node* root);
 
-		// Copy Data to root from other_root
-		Node* CopyAVLTree(Node* root, const Node* other_root);
+		// delete, Or Destroy In Place For A Node Living In A compact() Block
+		void DeleteNode(Node* node);
 
-		// Remove Minimal Element + Balance Tree
-		Node* RemBalMin(Node* root, Node* minroot);
+		// Node Off The Free List (data assigned), Else new
+		Node* NewNode(const T& data);
 
-		// Get The Correct Height
-		T_Height height(Node* root) const;
+		// Onto The Free List When reuse_nodes() Is On, Else DeleteNode()
+		void RecycleNode(Node* node);
 
-		// Update Height
-		void update(Node* root);
+		// Copy other_root Without Recursion, Taking Nodes From reuse Before Allocating
+		Node* CopyAVLTree(const Node* other_root, std::vector<Node*>& reuse);
 
-		// Get Balance Factor
-		signed char balance_factor(Node* root) const;
+		// Append Nodes In Order
+		static void Flatten(Node* root, std::vector<Node*>& nodes);
 
-		// Balance Root + Update Height
-		Node* balance(Node* root);
+		// Link count Sorted Nodes Into A Perfectly Balanced Tree
+		static Node* BuildBalanced(Node* const* nodes, std::size_t count);
 
 		// Get Distance
 		int GetDistance(const T& val, Node* LCA, bool side) const;
@@ -164,22 +493,82 @@ namespace Tree
 		// R || Erase Element + Balance
 		Node* erase_(Node* root, const T& data);
 
+		// Take root Out Of Its Subtree, Its Successor Takes Its Place (recycled; the result is not balanced)
+		Node* RemoveNode(Node* root);
+
 		// R || Find Element
 		Node* find_(Node* root, const T& data) const;
 
+		// R || Order In (lo, hi), Balance Rule And size_l / size_r Of Every Node Below root
+		static bool CheckSubtree(const Node* root, const T* lo, const T* hi, std::size_t& count);
+
+		// Arithmetic Keys (scalar_key): one compare per level, no recursion
+		// (a branchless child[data > node->data] pick was measured slower: it stalls the speculative descent)
+		using scalar_key = std::integral_constant<bool, std::is_arithmetic<T>::value>;
+
+		void Insert(const T& data, std::false_type);
+		void Insert(const T& data, std::true_type);
+		Node* Find(const T& data, std::false_type) const;
+		Node* Find(const T& data, std::true_type) const;
+
+		// First Element >= data (or_equal == false: > data), nullptr if none
+		const Node* LowerBound(const T& data, bool or_equal) const;
+
+		// Number Of Elements < data (or_equal: <= data)
+		std::size_t Rank(const T& data, bool or_equal) const;
+
+		// Element With index Smaller Elements, nullptr if index >= size
+		const Node* Select(std::size_t index) const;
+
+		// One Key Of A Batched Rank Query
+		struct RankQuery
+		{
+			const T* key;
+			std::size_t index; // position in the caller's input
+			std::size_t rank;  // elements < *key
+			bool found;
+		};
+
+		// R || Rank Every Query Of [first, last) (sorted by key) In One Shared Descent; less = elements left of root
+		static void RankBatch(const Node* root, RankQuery* first, RankQuery* last, std::size_t less);
+
+		// Move hint To data: Climb To The Nearest Ancestor Bounding data, Then Descend (nullptr if missing)
+		Node* Seek(Finger& hint, const T& data) const;
+
+		// In-Order Walk Of [*lo, *hi] (nullptr: unbounded) With An Explicit Stack; the right child of every
+		// pushed node is prefetched, so it is in cache when the left subtree is done. Stops when visit returns false
+		template<typename F>
+		static void Scan(const Node* root, const T* lo, const T* hi, F visit);
+
 		// _Private Methods
+	protected:
+		// Erase path[depth - 1], path[0] Being root: balances back up the path, no key is compared
+		// (a node-based erase for owners that know where a node is, e.g. through parent links in an augmentation)
+		void EraseAt(Node* const* path, std::size_t depth);
+
+		// Apply Sorted, Unique (data, keep) Pairs In One Pass: flatten + merge + balanced rebuild.
+		// New keys past 65535 elements are dropped (the largest ones); returns how many
+		std::size_t MergeSorted(const std::vector<std::pair<T, bool>>& ops);
+
 	public: // Constructors
 		AVLTree() : root(nullptr) {}
 		AVLTree(const T& data) : root(new Node(data)) {}
 		AVLTree(const std::initializer_list<T>& init_list);
 
-		AVLTree(const AVLTree<T, T_Height>& other);
-		AVLTree(AVLTree<T, T_Height>&& other);
+		AVLTree(const AVLTree<T, T_Height, Augment, Balancing>& other);
+		AVLTree(AVLTree<T, T_Height, Augment, Balancing>&& other) noexcept;
+
+		AVLTree<T, T_Height, Augment, Balancing>& operator=(const AVLTree<T, T_Height, Augment, Balancing>& other);
+		AVLTree<T, T_Height, Augment, Balancing>& operator=(AVLTree<T, T_Height, Augment, Balancing>&& other) noexcept;
+		// Compare Contents In Order (shape does not matter)
+		bool operator==(const AVLTree<T, T_Height, Augment, Balancing>& other) const;
+		bool operator!=(const AVLTree<T, T_Height, Augment, Balancing>& other) const;
 
-		AVLTree<T, T_Height>& operator=(const AVLTree<T, T_Height>& other);
-		AVLTree<T, T_Height>& operator=(AVLTree<T, T_Height>&& other) noexcept;
-		bool operator==(const AVLTree<T, T_Height>& other) const;
-		bool operator!=(const AVLTree<T, T_Height>& other) const;
+		// Lexicographic Compare: < 0, 0, > 0
+		int compare(const AVLTree<T, T_Height, Augment, Balancing>& other) const;
+#if ((defined(_MSVC_LANG) && _MSVC_LANG >= 202002L) || __cplusplus >= 202002L)
+		std::weak_ordering operator<=>(const AVLTree<T, T_Height, Augment, Balancing>& other) const;
+#endif
 
 		virtual ~AVLTree();
 	public: // Methods
@@ -187,10 +576,20 @@ namespace Tree
 		bool erase(const T& data);
 		const Node* find(const T& data) const&;
 		void clear();
-		void swap(Tree::AVLTree<T, T_Height>& AvlTree);
+		void swap(Tree::AVLTree<T, T_Height, Augment, Balancing>& AvlTree) noexcept;
 		unsigned short size() const;
 		unsigned int distance(const T& element1, const T& element2) const;
 
+		// out[i] = Number Of Elements < sorted_keys[i]: keys in ascending order share one descent
+		// (a key is split off only where the paths part), unsorted keys fall back to one descent each
+		void rank_batch(const std::vector<T>& sorted_keys, std::vector<std::size_t>& out) const;
+
+		// out[i] = distance(pairs[i].first, pairs[i].second): each side of the pairs sorted (if needed) and ranked by rank_batch's descent
+		void distance_batch(const std::vector<std::pair<T, T>>& pairs, std::vector<unsigned int>& out) const;
+
+		// Element With index Smaller Elements (nullptr if index >= size()), O(log n) from the subtree counts
+		const Node* select(std::size_t index) const;
+
 	public: // iterators
 		using iterator = Iterator;
 		using const_iterator = Iterator;
@@ -205,17 +604,98 @@ namespace Tree
 		NODISCARD const_reverse_iterator crbegin() const;
 		NODISCARD reverse_iterator rend() const;
 		NODISCARD const_reverse_iterator crend() const;
+
+	public: // cursors + views
+		using cursor = Cursor;
+		using range_type = View<Cursor>;
+		using reverse_range_type = View<std::reverse_iterator<Cursor>>;
+
+		NODISCARD cursor cursor_begin() const noexcept;
+		NODISCARD cursor cursor_end() const noexcept;
+
+		// Elements In [lo, hi], O(log n) to build, size() without walking
+		NODISCARD range_type range(const T& lo, const T& hi) const;
+		NODISCARD reverse_range_type reverse_range(const T& lo, const T& hi) const;
+
+		// Whole Tree (or [lo, hi]) Cut Into parts Ranges Of Equal Size, By Rank (for parallel scans)
+		NODISCARD std::vector<range_type> split_range(std::size_t parts) const;
+		NODISCARD std::vector<range_type> split_range(const T& lo, const T& hi, std::size_t parts) const;
+
+	public: // bulk export
+		// Every Element In Order To out (prefetching walk, no iterator state), Returns The End Of The Output
+		template<typename OutputIt>
+		OutputIt copy_to(OutputIt out) const;
+
+		// visitor(element) For Every Element In Order
+		template<typename F>
+		void for_each(F visitor) const;
+
+		// Up To n Elements Of [lo, hi] Into buf, Returns How Many Were Written
+		// (n reached: continue from just above buf[n - 1])
+		std::size_t export_range(const T& lo, const T& hi, T* buf, std::size_t n) const;
+
+	public: // finger search
+		using finger = Finger;
+
+		// Find Starting From hint (moved to data): comparisons grow with the distance to the previous key
+		const Node* find_from(finger& hint, const T& data) const;
+
+		// Insert Starting From hint (moved to the new node); sizes and heights are still fixed up to root
+		bool insert_near(finger& hint, const T& data);
+
+	public: // memory layout
+		// Move Every Node Into One Contiguous Block In Breadth-First Order (contents unchanged;
+		// iterators, cursors and node pointers are invalidated)
+		void compact();
+
+		// One Bounded Step Of compact(): visits at most budget links, true once the pass is over
+		// (insert/erase between steps are fine, nodes linked behind the walk wait for the next pass)
+		bool compact_step(std::size_t budget);
+
+	public: // node reuse
+		// on: erase() / clear() / copy assignment keep their nodes on a free list that inserts take from
+		// (no heap call while the tree stays within its capacity); off: the spare nodes are freed
+		void reuse_nodes(bool on = true);
+
+		// Spare Nodes Until size() + Spares >= n (at most 65535), Turns reuse_nodes() On; T default-constructible
+		void reserve(std::size_t n);
+
+		// Free Every Spare Node (reuse_nodes() stays as it is)
+		void shrink_to_fit();
+
+		// size() + Spare Nodes
+		std::size_t capacity() const;
+
+	public: // stepwise descent
+		// One find() Split Into Steps, For Lookups That Interleave Their Descents (CoroutineLookup.hpp):
+		// start at descent_begin(), stop at nullptr (missing) or at a node whose data == data
+		const Node* descent_begin() const noexcept;
+		static const Node* descent_next(const Node* node, const T& data);
+
+	public: // incremental destruction
+		// Move The Whole Tree (nodes, spares, compact() blocks) Out In O(1), this Is Left Empty:
+		// destroy the result on another thread (Tree::Reclaimer), or free it with clear_step()
+		NODISCARD AVLTree<T, T_Height, Augment, Balancing> detach();
+
+		// clear() In Steps: the first call of a pass empties the tree in O(1), every call frees at most
+		// budget nodes; true once the pass is over (elements inserted between the steps stay)
+		bool clear_step(std::size_t budget);
+
+	public: // debugging
+		// Every Structural Invariant Holds: search order, the balance rule of the policy (AVL: stored heights
+		// and |balance| <= 1), size_l / size_r of every node, size() (O(n), for tests and fuzzers)
+		bool check_invariants() const;
 	};
 
 	//
-	// Private Methods
+	// AVLBalance
 	//
 
 	// Balancing
 
 	// Single Left Rotation
-	template<typename T, typename T_Height>
-	inline void AVLTree<T, T_Height>::SingleLeftRotation(Node*& root)
+	template<typename Node, typename T_Height, typename Augment>
+	inline void AVLBalance<Node, T_Height, Augment>::SingleLeftRotation(Node*& root)
 	{
 		Node* root_copy = root;
 		root = root->right;
@@ -224,11 +704,12 @@ namespace Tree
 
 		update(root->left);
 		update(root);
+		Augment::rotate(root);
 	}
 
 	// Double Left Roration
-	template<typename T, typename T_Height>
-	inline void AVLTree<T, T_Height>::DoubleLeftRotation(Node*& root)
+	template<typename Node, typename T_Height, typename Augment>
+	inline void AVLBalance<Node, T_Height, Augment>::DoubleLeftRotation(Node*& root)
 	{
 		Node* root_copy_main = root, * root_copy_right = root->right;
 		root = root_copy_right->left;
@@ -240,11 +721,12 @@ namespace Tree
 		update(root->left);
 		update(root->right);
 		update(root);
+		Augment::rotate(root);
 	}
 
 	// Single Right Rotation
-	template<typename T, typename T_Height>
-	inline void AVLTree<T, T_Height>::SingleRightRotation(Node*& root)
+	template<typename Node, typename T_Height, typename Augment>
+	inline void AVLBalance<Node, T_Height, Augment>::SingleRightRotation(Node*& root)
 	{
 		Node* root_copy = root;
 		root = root->left;
@@ -253,11 +735,12 @@ namespace Tree
 
 		update(root->right);
 		update(root);
+		Augment::rotate(root);
 	}
 
 	// Double Right Roration
-	template<typename T, typename T_Height>
-	inline void AVLTree<T, T_Height>::DoubleRightRotation(Node*& root)
+	template<typename Node, typename T_Height, typename Augment>
+	inline void AVLBalance<Node, T_Height, Augment>::DoubleRightRotation(Node*& root)
 	{
 		Node* root_copy_main = root, * root_copy_left = root->left;
 		root = root_copy_left->right;
@@ -269,78 +752,93 @@ namespace Tree
 		update(root->right);
 		update(root->left);
 		update(root);
+		Augment::rotate(root);
 	}
 
 	// _Balancing
 
-	template<typename T, typename T_Height>
-	inline void AVLTree<T, T_Height>::IsEqual(const Node* myRoot, const Node* other) const
+	// Get Minimal Element
+	template<typename Node, typename T_Height, typename Augment>
+	inline Node* AVLBalance<Node, T_Height, Augment>::GetMinElement(Node* root)
 	{
-		if (!isSuccessfully)
-			return;
-
-		if (myRoot != nullptr && other != nullptr)
-		{
-			if (myRoot->data != other->data)
-			{
-				isSuccessfully = false;
-			}
-
-			IsEqual(myRoot->right, other->right);
-			IsEqual(myRoot->left, other->left);
-		}
-		else if (myRoot || other)
-		{
-			isSuccessfully = false;
-		}
+		return root->left == nullptr ? root : GetMinElement(root->left);
 	}
 
-	// Remove All Elements (NEED THAT SIZE > 0)
-	template<typename T, typename T_Height>
-	inline typename AVLTree<T, T_Height>::Node* AVLTree<T, T_Height>::RemoveAllNode(Node* root)
+	// Get The Correct Height
+	template<typename Node, typename T_Height, typename Augment>
+	inline T_Height AVLBalance<Node, T_Height, Augment>::height(const Node* root)
 	{
-		if (root->left != nullptr)
-		{
-			root->left = RemoveAllNode(root->left);
-		}
-		if (root->right != nullptr)
-		{
-			root->right = RemoveAllNode(root->right);
-		}
-
-		delete root;
-		return nullptr;
+		return root ? root->height : 0;
 	}
 
-	// Copy Data to root from other_root
-	template<typename T, typename T_Height>
-	inline typename AVLTree<T, T_Height>::Node* AVLTree<T, T_Height>::CopyAVLTree(Node* root, const Node* other_root)
+	template<typename Node, typename T_Height, typename Augment>
+	inline unsigned char AVLBalance<Node, T_Height, Augment>::abs(signed char element)
 	{
-		if (other_root == nullptr)
-		{
-			return nullptr;
-		}
+		return element > 0 ? element : -element;
+	}
 
-		root = new Node(other_root->data);
-		root->height = other_root->height;
-		root->size_l = other_root->size_l;
-		root->size_r = other_root->size_r;
-		root->left = CopyAVLTree(root->left, other_root->left);
-		root->right = CopyAVLTree(root->right, other_root->right);
+	// Update Height
+	template<typename Node, typename T_Height, typename Augment>
+	inline void AVLBalance<Node, T_Height, Augment>::update(Node* root)
+	{
+		root->height = (height(root->left) > height(root->right) ? height(root->left) : height(root->right)) + 1;
+		root->size_r = (root->right ? root->right->size_r + root->right->size_l + 1 : 0);
+		root->size_l = (root->left ? root->left->size_l + root->left->size_r + 1 : 0);
+		Augment::update(root);
+	}
 
-		return root;
+	// Get Balance Factor
+	template<typename Node, typename T_Height, typename Augment>
+	inline signed char AVLBalance<Node, T_Height, Augment>::balance_factor(const Node* root)
+	{
+		return height(root->left) - height(root->right);
 	}
 
-	// Remove Minimal Element + Balance Tree
-	template<typename T, typename T_Height>
-	inline typename AVLTree<T, T_Height>::Node* AVLTree<T, T_Height>::RemBalMin(Node* root, Node* minroot)
+	// Balance Root + Update Height
+	template<typename Node, typename T_Height, typename Augment>
+	inline Node* AVLBalance<Node, T_Height, Augment>::balance(Node* root)
 	{
-		if (root->left == minroot)
+		if (root)
 		{
-			Node* copy_minroot = minroot;
-			root->left = minroot->right;
-			delete minroot;
-		}
+			signed char bal_factor = balance_factor(root);
+			if (abs(bal_factor) <= 1)
+			{
+				update(root);
+			}
+			else
+			{
+				if (bal_factor == -2) // Left Rotation
+				{
+					signed char bal_factor_right = balance_factor(root->right);
+					if (bal_factor_right <= 0) // Single Left Rotation
+						SingleLeftRotation(root);
+
+					else if (bal_factor_right > 0) // Double Left Roration
+						DoubleLeftRotation(root);
+				}
+				else if (bal_factor == 2) // Right Rotation
+				{
+					signed char bal_factor_left = balance_factor(root->left);
+					if (bal_factor_left >= 0) // Single Right Rotation
+						SingleRightRotation(root);
+
+					else if (bal_factor_left < 0) // Double Right Roration
+						DoubleRightRotation(root);
+				}
+			}
+		}
+
+		return root;
+	}
+
+	// Unlink Minimal Element (not deleted) + Balance Tree
+	template<typename Node, typename T_Height, typename Augment>
+	inline Node* AVLBalance<Node, T_Height, Augment>::RemBalMin(Node* root, Node* minroot)
+	{
+		if (root->left == minroot)
+		{
+			root->left = minroot->right;
+		}
 		else
 		{
 			root->left = RemBalMin(root->left, minroot);
@@ -349,197 +847,637 @@ namespace Tree
 		return balance(root);
 	}
 
-	// Get The Correct Height
-	template<typename T, typename T_Height>
-	inline T_Height AVLTree<T, T_Height>::height(Node* root) const
+	// Update After A Rebuild From Sorted Nodes (children done)
+	template<typename Node, typename T_Height, typename Augment>
+	inline void AVLBalance<Node, T_Height, Augment>::build(Node* root)
+	{
+		update(root);
+	}
+
+	// Balance Rule Of root Holds (children checked before)
+	template<typename Node, typename T_Height, typename Augment>
+	inline bool AVLBalance<Node, T_Height, Augment>::valid(const Node* root)
+	{
+		T_Height left = height(root->left), right = height(root->right);
+		return root->height == (left > right ? left : right) + 1 && left <= right + 1 && right <= left + 1;
+	}
+
+	// _AVLBalance
+
+	//
+	// WAVLBalance
+	//
+
+	template<typename Node, typename T_Height, typename Augment>
+	inline Node* WAVLBalance<Node, T_Height, Augment>::GetMinElement(Node* root)
+	{
+		return root->left == nullptr ? root : GetMinElement(root->left);
+	}
+
+	// Rank (0 for nullptr)
+	template<typename Node, typename T_Height, typename Augment>
+	inline T_Height WAVLBalance<Node, T_Height, Augment>::height(const Node* root)
 	{
 		return root ? root->height : 0;
 	}
 
+	// Update Sizes + Augmentation (the rank only changes by promote / demote)
+	template<typename Node, typename T_Height, typename Augment>
+	inline void WAVLBalance<Node, T_Height, Augment>::update(Node* root)
+	{
+		root->size_r = (root->right ? root->right->size_r + root->right->size_l + 1 : 0);
+		root->size_l = (root->left ? root->left->size_l + root->left->size_r + 1 : 0);
+		Augment::update(root);
+	}
 
-	// static Methods
+	// Rotations Keep The Ranks (balance() sets them)
+	template<typename Node, typename T_Height, typename Augment>
+	inline Node* WAVLBalance<Node, T_Height, Augment>::RotateLeft(Node* root)
+	{
+		Node* pivot = root->right;
+		root->right = pivot->left;
+		pivot->left = root;
 
-	// Get Next Element
-	template<typename T, typename T_Height>
-	inline typename AVLTree<T, T_Height>::Node* AVLTree<T, T_Height>::getNext(Node* current, Node* root)
+		update(root);
+		update(pivot);
+		return pivot;
+	}
+
+	template<typename Node, typename T_Height, typename Augment>
+	inline Node* WAVLBalance<Node, T_Height, Augment>::RotateRight(Node* root)
 	{
-		Node* return_node = nullptr;
-		if (current->right)
+		Node* pivot = root->left;
+		root->left = pivot->right;
+		pivot->right = root;
+
+		update(root);
+		update(pivot);
+		return pivot;
+	}
+
+	// Fix The Rank Rule At root: a 0-child (insert), a 3-child or a 2,2 leaf (erase)
+	template<typename Node, typename T_Height, typename Augment>
+	inline Node* WAVLBalance<Node, T_Height, Augment>::balance(Node* root)
+	{
+		if (root == nullptr)
+			return root;
+
+		const int left = root->height - height(root->left), right = root->height - height(root->right);
+
+		// insert: 0,1 -> promote; 0,2 -> rotate (single if the inner grandchild is a 2-child)
+		if (left == 0 || right == 0)
 		{
-			return_node = GetMinElement(current->right);
+			if (left + right == 1)
+			{
+				++root->height;
+				update(root);
+				return root;
+			}
+
+			--root->height;
+			if (left == 0)
+			{
+				Node* child = root->left;
+				if (child->height - height(child->right) != 2)
+				{
+					++child->right->height;
+					--child->height;
+					root->left = RotateLeft(child);
+				}
+				root = RotateRight(root);
+			}
+			else
+			{
+				Node* child = root->right;
+				if (child->height - height(child->left) != 2)
+				{
+					++child->left->height;
+					--child->height;
+					root->right = RotateRight(child);
+				}
+				root = RotateLeft(root);
+			}
+
+			Augment::rotate(root);
+			return root;
 		}
-		else
+
+		// erase: 3-child next to a 2-child -> demote; next to a 2,2 node -> demote both; else rotate
+		if (left == 3 || right == 3)
 		{
-			return_node = GetLvlUp(current->data, root);
+			Node* sibling = (left == 3 ? root->right : root->left);
+			const int inner = sibling->height - height(left == 3 ? sibling->left : sibling->right);
+			const int outer = sibling->height - height(left == 3 ? sibling->right : sibling->left);
+
+			if (left == 2 || right == 2 || (inner == 2 && outer == 2))
+			{
+				if (left != 2 && right != 2)
+					--sibling->height;
+				--root->height;
+				update(root);
+				return root;
+			}
+
+			Node* demoted = root;
+			if (outer == 1)
+			{
+				++sibling->height;
+				--root->height;
+				root = (left == 3 ? RotateLeft(root) : RotateRight(root));
+
+				// a leaf keeps rank 1
+				if (demoted->left == nullptr && demoted->right == nullptr)
+					demoted->height = 1;
+			}
+			else
+			{
+				Node* grandchild = (left == 3 ? sibling->left : sibling->right);
+				grandchild->height += 2;
+				--sibling->height;
+				root->height -= 2;
+				if (left == 3)
+				{
+					root->right = RotateRight(sibling);
+					root = RotateLeft(root);
+				}
+				else
+				{
+					root->left = RotateLeft(sibling);
+					root = RotateRight(root);
+				}
+			}
+
+			Augment::rotate(root);
+			return root;
 		}
 
-		return return_node;
+		// erase: a leaf left with rank 2
+		if (root->left == nullptr && root->right == nullptr)
+			root->height = 1;
+
+		update(root);
+		return root;
 	}
 
-	// Get Previous Element
-	template<typename T, typename T_Height>
-	inline typename AVLTree<T, T_Height>::Node* AVLTree<T, T_Height>::getPrevious(Node* current, Node* root)
+	template<typename Node, typename T_Height, typename Augment>
+	inline Node* WAVLBalance<Node, T_Height, Augment>::RemBalMin(Node* root, Node* minroot)
 	{
-		Node* return_node = nullptr;
-		if (current->left)
+		if (root->left == minroot)
+			root->left = minroot->right;
+		else
+			root->left = RemBalMin(root->left, minroot);
+
+		return balance(root);
+	}
+
+	// A Balanced Rebuild Is An AVL Tree: rank = height
+	template<typename Node, typename T_Height, typename Augment>
+	inline void WAVLBalance<Node, T_Height, Augment>::build(Node* root)
+	{
+		root->height = (height(root->left) > height(root->right) ? height(root->left) : height(root->right)) + 1;
+		update(root);
+	}
+
+	template<typename Node, typename T_Height, typename Augment>
+	inline bool WAVLBalance<Node, T_Height, Augment>::valid(const Node* root)
+	{
+		const int left = root->height - height(root->left), right = root->height - height(root->right);
+		return left >= 1 && left <= 2 && right >= 1 && right <= 2
+			&& (root->left != nullptr || root->right != nullptr || root->height == 1);
+	}
+
+	// _WAVLBalance
+
+	//
+	// WeightBalance
+	//
+
+	template<typename Node, typename T_Height, typename Augment>
+	constexpr std::size_t WeightBalance<Node, T_Height, Augment>::delta;
+
+	template<typename Node, typename T_Height, typename Augment>
+	constexpr std::size_t WeightBalance<Node, T_Height, Augment>::gamma;
+
+	template<typename Node, typename T_Height, typename Augment>
+	inline Node* WeightBalance<Node, T_Height, Augment>::GetMinElement(Node* root)
+	{
+		return root->left == nullptr ? root : GetMinElement(root->left);
+	}
+
+	template<typename Node, typename T_Height, typename Augment>
+	inline std::size_t WeightBalance<Node, T_Height, Augment>::weight(const Node* root)
+	{
+		return root ? root->size_l + root->size_r + 2u : 1u;
+	}
+
+	// Update Sizes + Augmentation
+	template<typename Node, typename T_Height, typename Augment>
+	inline void WeightBalance<Node, T_Height, Augment>::update(Node* root)
+	{
+		root->size_r = (root->right ? root->right->size_r + root->right->size_l + 1 : 0);
+		root->size_l = (root->left ? root->left->size_l + root->left->size_r + 1 : 0);
+		Augment::update(root);
+	}
+
+	template<typename Node, typename T_Height, typename Augment>
+	inline Node* WeightBalance<Node, T_Height, Augment>::RotateLeft(Node* root)
+	{
+		Node* pivot = root->right;
+		root->right = pivot->left;
+		pivot->left = root;
+
+		update(root);
+		update(pivot);
+		return pivot;
+	}
+
+	template<typename Node, typename T_Height, typename Augment>
+	inline Node* WeightBalance<Node, T_Height, Augment>::RotateRight(Node* root)
+	{
+		Node* pivot = root->left;
+		root->left = pivot->right;
+		pivot->right = root;
+
+		update(root);
+		update(pivot);
+		return pivot;
+	}
+
+	// Rotate At root When One Side Weighs More Than delta Times The Other
+	template<typename Node, typename T_Height, typename Augment>
+	inline Node* WeightBalance<Node, T_Height, Augment>::balance(Node* root)
+	{
+		if (root == nullptr)
+			return root;
+
+		update(root);
+		const std::size_t left = weight(root->left), right = weight(root->right);
+		if (right > delta * left)
 		{
-			return_node = GetMaxElement(current->left);
+			// double when the inner grandchild is the heavy one
+			if (weight(root->right->left) >= gamma * weight(root->right->right))
+				root->right = RotateRight(root->right);
+			root = RotateLeft(root);
+			Augment::rotate(root);
+		}
+		else if (left > delta * right)
+		{
+			if (weight(root->left->right) >= gamma * weight(root->left->left))
+				root->left = RotateLeft(root->left);
+			root = RotateRight(root);
+			Augment::rotate(root);
 		}
+
+		return root;
+	}
+
+	template<typename Node, typename T_Height, typename Augment>
+	inline Node* WeightBalance<Node, T_Height, Augment>::RemBalMin(Node* root, Node* minroot)
+	{
+		if (root->left == minroot)
+			root->left = minroot->right;
 		else
+			root->left = RemBalMin(root->left, minroot);
+
+		return balance(root);
+	}
+
+	template<typename Node, typename T_Height, typename Augment>
+	inline void WeightBalance<Node, T_Height, Augment>::build(Node* root)
+	{
+		update(root);
+	}
+
+	template<typename Node, typename T_Height, typename Augment>
+	inline bool WeightBalance<Node, T_Height, Augment>::valid(const Node* root)
+	{
+		const std::size_t left = weight(root->left), right = weight(root->right);
+		return left <= delta * right && right <= delta * left;
+	}
+
+	// _WeightBalance
+
+	//
+	// Private Methods
+	//
+
+	// Remove All Elements (NEED THAT SIZE > 0)
+	template<typename T, typename T_Height, typename Augment, typename Balancing>
+	inline typename AVLTree<T, T_Height, Augment, Balancing>::Node* AVLTree<T, T_Height, Augment, Balancing>::RemoveAllNode(Node* root)
+	{
+		if (root->left != nullptr)
 		{
-			return_node = GetLvlDw(current->data, root);
+			root->left = RemoveAllNode(root->left);
+		}
+		if (root->right != nullptr)
+		{
+			root->right = RemoveAllNode(root->right);
 		}
 
-		return return_node;
+		RecycleNode(root);
+		return nullptr;
 	}
 
-	// Get Next Lvl UP ! DO NOT USE FOR MID ELEMENT
-	template<typename T, typename T_Height>
-	inline typename AVLTree<T, T_Height>::Node* AVLTree<T, T_Height>::GetLvlUp(const T& data, Node* root)
+	// delete, Or Destroy In Place For A Node Living In A compact() Block
+	template<typename T, typename T_Height, typename Augment, typename Balancing>
+	inline void AVLTree<T, T_Height, Augment, Balancing>::DeleteNode(Node* node)
 	{
-		if (root && root->left)
+		if (layout_)
 		{
-			if (root->left->data <= data)
+			std::vector<typename Layout::Block>& blocks = layout_->blocks;
+			for (std::size_t i = 0; i < blocks.size(); ++i)
 			{
-				if (root->data > data)
-				{
-					if (GetMaxElement(root->left)->data > data)
-					{
-						return GetLvlUp(data, root->left->right);
-					}
-					return root;
-				}
-				else if (root->data < data)
+				if (!blocks[i].owns(node))
+					continue;
+
+				node->~Node();
+				if (layout_->active && i + 1 == blocks.size())
+					layout_->dead[node - blocks[i].nodes] = true;
+
+				// the last node of a block frees it, unless a pass is still filling it
+				if (--blocks[i].live == 0 && !(layout_->active && i + 1 == blocks.size()))
 				{
-					return GetLvlUp(data, root->right);
+					::operator delete(blocks[i].nodes);
+					blocks.erase(blocks.begin() + i);
 				}
+				return;
 			}
-			return GetLvlUp(data, root->left);
 		}
 
-		return root;
+		delete node;
 	}
 
+	// Node Off The Free List (data assigned), Else new
+	template<typename T, typename T_Height, typename Augment, typename Balancing>
+	inline typename AVLTree<T, T_Height, Augment, Balancing>::Node* AVLTree<T, T_Height, Augment, Balancing>::NewNode(const T& data)
+	{
+		if (free_ == nullptr)
+			return new Node(data);
+
+		Node* node = free_;
+		free_ = node->right;
+		--free_count_;
+		Augment::place(static_cast<const Node*>(nullptr));
+
+		node->data = data;
+		node->left = node->right = nullptr;
+		node->height = 1;
+		node->size_l = node->size_r = 0;
+		static_cast<Augment&>(*node) = Augment(); // the old element's augmentation would be taken as computed
+		Augment::update(node);
+		return node;
+	}
 
-	// Get Next Lvl Down ! DO NOT USE FOR MID ELEMENT
-	template<typename T, typename T_Height>
-	inline typename AVLTree<T, T_Height>::Node* AVLTree<T, T_Height>::GetLvlDw(const T& data, Node* root)
+	// Onto The Free List When reuse_nodes() Is On, Else DeleteNode()
+	template<typename T, typename T_Height, typename Augment, typename Balancing>
+	inline void AVLTree<T, T_Height, Augment, Balancing>::RecycleNode(Node* node)
 	{
-		if (root && root->right)
+		// during a compact_step() pass DeleteNode() marks the erased target slots
+		if (!reuse_ || (layout_ && layout_->active))
 		{
-			if (root->right->data >= data)
-			{
-				if (root->data < data)
-				{
-					if (GetMinElement(root->right)->data < data)
-					{
-						return GetLvlDw(data, root->right->left);
-					}
+			DeleteNode(node);
+			return;
+		}
 
-					return root;
-				}
-				else if (root->data > data)
-				{
-					return GetLvlDw(data, root->left);
-				}
+		node->right = free_;
+		free_ = node;
+		++free_count_;
+	}
+
+	// Copy other_root Without Recursion, Taking Nodes From reuse Before Allocating
+	template<typename T, typename T_Height, typename Augment, typename Balancing>
+	inline typename AVLTree<T, T_Height, Augment, Balancing>::Node* AVLTree<T, T_Height, Augment, Balancing>::CopyAVLTree(const Node* other_root, std::vector<Node*>& reuse)
+	{
+		Node* root = nullptr;
+		std::vector<std::pair<const Node*, Node**>> pending; // (source, where its copy is linked)
+		if (other_root != nullptr)
+		{
+			pending.emplace_back(other_root, &root);
+		}
+
+		while (!pending.empty())
+		{
+			const Node* other_node = pending.back().first;
+			Node** link = pending.back().second;
+			pending.pop_back();
+
+			Node* node;
+			if (reuse.empty())
+			{
+				node = NewNode(other_node->data);
 			}
-			return GetLvlDw(data, root->right);
+			else
+			{
+				node = reuse.back();
+				reuse.pop_back();
+				node->data = other_node->data;
+			}
+
+			node->left = node->right = nullptr;
+			node->height = other_node->height;
+			node->size_l = other_node->size_l;
+			node->size_r = other_node->size_r;
+			static_cast<Augment&>(*node) = static_cast<const Augment&>(*other_node);
+			*link = node;
+
+			if (other_node->right)
+				pending.emplace_back(other_node->right, &node->right);
+			if (other_node->left)
+				pending.emplace_back(other_node->left, &node->left);
 		}
 
 		return root;
 	}
 
-	// Get Minimal Element
-	template<typename T, typename T_Height>
-	inline typename AVLTree<T, T_Height>::Node* AVLTree<T, T_Height>::GetMinElement(Node* root)
+	// Append Nodes In Order
+	template<typename T, typename T_Height, typename Augment, typename Balancing>
+	inline void AVLTree<T, T_Height, Augment, Balancing>::Flatten(Node* root, std::vector<Node*>& nodes)
 	{
-		return root->left == nullptr ? root : GetMinElement(root->left);
+		while (root)
+		{
+			Flatten(root->left, nodes);
+			nodes.push_back(root);
+			root = root->right;
+		}
 	}
 
-	// Get Maximal Element
-	template<typename T, typename T_Height>
-	inline typename AVLTree<T, T_Height>::Node* AVLTree<T, T_Height>::GetMaxElement(Node* root)
+	// Link count Sorted Nodes Into A Perfectly Balanced Tree
+	template<typename T, typename T_Height, typename Augment, typename Balancing>
+	inline typename AVLTree<T, T_Height, Augment, Balancing>::Node* AVLTree<T, T_Height, Augment, Balancing>::BuildBalanced(Node* const* nodes, std::size_t count)
 	{
-		return root->right == nullptr ? root : GetMaxElement(root->right);
-	}
+		if (count == 0)
+		{
+			return nullptr;
+		}
 
-	// _static Methods
+		std::size_t mid = count / 2;
+		Node* root = nodes[mid];
+		root->left = BuildBalanced(nodes, mid);
+		root->right = BuildBalanced(nodes + mid + 1, count - mid - 1);
+		Balance::build(root);
+
+		return root;
+	}
 
-	template<typename T, typename T_Height>
-	inline unsigned char AVLTree<T, T_Height>::abs(signed char element) const
+	// Apply Sorted, Unique (data, keep) Pairs In One Pass: flatten + merge + balanced rebuild
+	template<typename T, typename T_Height, typename Augment, typename Balancing>
+	inline std::size_t AVLTree<T, T_Height, Augment, Balancing>::MergeSorted(const std::vector<std::pair<T, bool>>& ops)
 	{
-		return element > 0 ? element : -element;
+		std::vector<Node*> old_nodes, nodes;
+		old_nodes.reserve(size_);
+		Flatten(root, old_nodes);
+
+		// room for new keys once every erase is applied: size_ is an unsigned short
+		std::size_t erased = 0;
+		typename std::vector<Node*>::iterator it = old_nodes.begin();
+		for (const std::pair<T, bool>& op : ops)
+		{
+			while (it != old_nodes.end() && (*it)->data < op.first)
+				++it;
+			if (it != old_nodes.end() && (*it)->data == op.first)
+				erased += !op.second;
+		}
+		std::size_t room = USHRT_MAX - (old_nodes.size() - erased), dropped = 0;
+		nodes.reserve(std::min<std::size_t>(old_nodes.size() + ops.size(), USHRT_MAX));
+
+		it = old_nodes.begin();
+		for (const std::pair<T, bool>& op : ops)
+		{
+			while (it != old_nodes.end() && (*it)->data < op.first)
+				nodes.push_back(*it++);
+
+			bool exists = (it != old_nodes.end() && (*it)->data == op.first);
+			if (op.second && exists)
+				nodes.push_back(*it++);
+			else if (op.second && room == 0)
+				++dropped;
+			else if (op.second)
+			{
+				nodes.push_back(NewNode(op.first));
+				--room;
+			}
+			else if (exists)
+			{
+				Augment::unlink(*it);
+				RecycleNode(*it++);
+			}
+		}
+		nodes.insert(nodes.end(), it, old_nodes.end());
+
+		root = BuildBalanced(nodes.data(), nodes.size());
+		size_ = static_cast<unsigned short>(nodes.size());
+		++version_;
+		return dropped;
 	}
 
-	// Update Height
-	template<typename T, typename T_Height>
-	inline void AVLTree<T, T_Height>::update(Node* root)
+
+	// static Methods
+
+	// Get Next Element
+	template<typename T, typename T_Height, typename Augment, typename Balancing>
+	inline typename AVLTree<T, T_Height, Augment, Balancing>::Node* AVLTree<T, T_Height, Augment, Balancing>::getNext(Node* current, Node* root)
 	{
-		root->height = (height(root->left) > height(root->right) ? height(root->left) : height(root->right)) + 1;
-		root->size_r = (root->right ? root->right->size_r + root->right->size_l + 1 : 0);
-		root->size_l = (root->left ? root->left->size_l + root->left->size_r + 1 : 0);
+		Node* return_node = nullptr;
+		if (current->right)
+		{
+			return_node = GetMinElement(current->right);
+		}
+		else
+		{
+			return_node = GetLvlUp(current->data, root);
+		}
+
+		return return_node;
 	}
 
-	// Get Balance Factor
-	template<typename T, typename T_Height>
-	inline signed char AVLTree<T, T_Height>::balance_factor(Node* root) const
+	// Get Previous Element
+	template<typename T, typename T_Height, typename Augment, typename Balancing>
+	inline typename AVLTree<T, T_Height, Augment, Balancing>::Node* AVLTree<T, T_Height, Augment, Balancing>::getPrevious(Node* current, Node* root)
 	{
-		return height(root->left) - height(root->right);
+		Node* return_node = nullptr;
+		if (current->left)
+		{
+			return_node = GetMaxElement(current->left);
+		}
+		else
+		{
+			return_node = GetLvlDw(current->data, root);
+		}
+
+		return return_node;
 	}
 
-	// Balance Root + Update Height
-	template<typename T, typename T_Height>
-	inline typename AVLTree<T, T_Height>::Node* AVLTree<T, T_Height>::balance(Node* root)
+	// Get Next Lvl UP: smallest element above data, one descent from root (any shape, not only AVL)
+	template<typename T, typename T_Height, typename Augment, typename Balancing>
+	inline typename AVLTree<T, T_Height, Augment, Balancing>::Node* AVLTree<T, T_Height, Augment, Balancing>::GetLvlUp(const T& data, Node* root)
 	{
-		if (root)
+		Node* next = nullptr;
+		while (root)
 		{
-			signed char bal_factor = balance_factor(root);
-			if (abs(bal_factor) <= 1)
+			if (data < root->data)
 			{
-				update(root);
+				next = root;
+				root = root->left;
 			}
 			else
-			{
-				if (bal_factor == -2) // Left Rotation
-				{
-					signed char bal_factor_right = balance_factor(root->right);
-					if (bal_factor_right <= 0) // Single Left Rotation
-						SingleLeftRotation(root);
+				root = root->right;
+		}
 
-					else if (bal_factor_right > 0) // Double Left Roration
-						DoubleLeftRotation(root);
-				}
-				else if (bal_factor == 2) // Right Rotation
-				{
-					signed char bal_factor_left = balance_factor(root->left);
-					if (bal_factor_left >= 0) // Single Right Rotation
-						SingleRightRotation(root);
+		return next;
+	}
 
-					else if (bal_factor_left < 0) // Double Right Roration
-						DoubleRightRotation(root);
-				}
+	// Get Next Lvl Down: largest element below data
+	template<typename T, typename T_Height, typename Augment, typename Balancing>
+	inline typename AVLTree<T, T_Height, Augment, Balancing>::Node* AVLTree<T, T_Height, Augment, Balancing>::GetLvlDw(const T& data, Node* root)
+	{
+		Node* previous = nullptr;
+		while (root)
+		{
+			if (root->data < data)
+			{
+				previous = root;
+				root = root->right;
 			}
+			else
+				root = root->left;
 		}
 
-		return root;
+		return previous;
+	}
+
+	// Get Minimal Element
+	template<typename T, typename T_Height, typename Augment, typename Balancing>
+	inline typename AVLTree<T, T_Height, Augment, Balancing>::Node* AVLTree<T, T_Height, Augment, Balancing>::GetMinElement(Node* root)
+	{
+		return root->left == nullptr ? root : GetMinElement(root->left);
 	}
 
-	template<typename T, typename T_Height>
-	inline int AVLTree<T, T_Height>::GetDistance(const T& val, Node* LCA, bool side) const // base LCA->data != val
+	// Get Maximal Element
+	template<typename T, typename T_Height, typename Augment, typename Balancing>
+	inline typename AVLTree<T, T_Height, Augment, Balancing>::Node* AVLTree<T, T_Height, Augment, Balancing>::GetMaxElement(Node* root)
+	{
+		return root->right == nullptr ? root : GetMaxElement(root->right);
+	}
+
+	// _static Methods
+
+	template<typename T, typename T_Height, typename Augment, typename Balancing>
+	inline int AVLTree<T, T_Height, Augment, Balancing>::GetDistance(const T& val, Node* LCA, bool side) const // base LCA->data != val
 	{
 		int elements = 0;
+		bool at_lca = true; // local, not a member: concurrent readers may call distance()
 
 		while (LCA && val != LCA->data)
 		{
 			if ((side == false && val < LCA->data) || (side == true && val > LCA->data))
 			{
-				elements += (isSuccessfully ? 0 : (side ? LCA->size_l : LCA->size_r)) + 1;
-				isSuccessfully = false;
+				elements += (at_lca ? 0 : (side ? LCA->size_l : LCA->size_r)) + 1;
+				at_lca = false;
 				LCA = (side ? LCA->right : LCA->left);
 			}
 			else
 			{
-				isSuccessfully = false;
+				at_lca = false;
 				LCA = (side ? LCA->left : LCA->right);
 			}
 		}
@@ -550,8 +1488,8 @@ namespace Tree
 
 
 	// Find LCA(Lowest Common Ancestor)
-	template<typename T, typename T_Height>
-	inline typename AVLTree<T, T_Height>::Node* AVLTree<T, T_Height>::LCA_find(const T& elem1, const T& elem2, Node* root) const
+	template<typename T, typename T_Height, typename Augment, typename Balancing>
+	inline typename AVLTree<T, T_Height, Augment, Balancing>::Node* AVLTree<T, T_Height, Augment, Balancing>::LCA_find(const T& elem1, const T& elem2, Node* root) const
 	{
 		while (root)
 		{
@@ -567,33 +1505,38 @@ namespace Tree
 
 
 	// R || Insert Element + Balance
-	template<typename T, typename T_Height>
-	inline typename AVLTree<T, T_Height>::Node* AVLTree<T, T_Height>::insert_(Node* root, const T& data)
+	template<typename T, typename T_Height, typename Augment, typename Balancing>
+	inline typename AVLTree<T, T_Height, Augment, Balancing>::Node* AVLTree<T, T_Height, Augment, Balancing>::insert_(Node* root, const T& data)
 	{
 		if (root == nullptr)
 		{
-			return new Node(data);
+			return lastNode = NewNode(data);
 		}
 		else if (data < root->data)
 		{
+			if (root->left == nullptr)
+				Augment::place(root);
 			root->left = insert_(root->left, data);
 		}
 		else if (data > root->data)
 		{
+			if (root->right == nullptr)
+				Augment::place(root);
 			root->right = insert_(root->right, data);
 		}
 		else if (root->data == data)
 		{
 			isSuccessfully = false;
+			lastNode = root;
 			return root;
 		}
 
-		return isSuccessfully ? balance(root) : root;
+		return isSuccessfully ? Balance::balance(root) : root;
 	}
 
 	// R || Erase Element + Balance
-	template<typename T, typename T_Height>
-	inline typename AVLTree<T, T_Height>::Node* AVLTree<T, T_Height>::erase_(Node* root, const T& data)
+	template<typename T, typename T_Height, typename Augment, typename Balancing>
+	inline typename AVLTree<T, T_Height, Augment, Balancing>::Node* AVLTree<T, T_Height, Augment, Balancing>::erase_(Node* root, const T& data)
 	{
 		if (root == nullptr)
 		{
@@ -602,28 +1545,7 @@ namespace Tree
 		}
 		else if (root->data == data)
 		{
-			if (root->right != nullptr)
-			{
-				Node* minroot = GetMinElement(root->right);
-				if (minroot == root->right)
-				{
-					Node* copy_root = root;
-					root = root->right;
-					root->left = copy_root->left;
-					delete copy_root;
-				}
-				else
-				{
-					root->data = minroot->data;
-					root->right = RemBalMin(root->right, minroot);
-				}
-			}
-			else
-			{
-				Node* copy_root = root;
-				root = root->left;
-				delete copy_root;
-			}
+			root = RemoveNode(root);
 		}
 		else if (data < root->data)
 		{
@@ -634,12 +1556,73 @@ namespace Tree
 			root->right = erase_(root->right, data);
 		}
 
-		return isSuccessfully ? balance(root) : root;
+		return isSuccessfully ? Balance::balance(root) : root;
+	}
+
+	// Take root Out Of Its Subtree, Its Successor Takes Its Place (recycled; the result is not balanced)
+	template<typename T, typename T_Height, typename Augment, typename Balancing>
+	inline typename AVLTree<T, T_Height, Augment, Balancing>::Node* AVLTree<T, T_Height, Augment, Balancing>::RemoveNode(Node* root)
+	{
+		Augment::unlink(root);
+		Node* copy_root = root;
+		if (root->right == nullptr)
+		{
+			root = root->left;
+		}
+		else
+		{
+			Node* minroot = GetMinElement(root->right);
+			root = minroot;
+			// the successor node takes root's place, so no element is copied
+			if (minroot != copy_root->right)
+				root->right = Balance::RemBalMin(copy_root->right, minroot);
+			root->left = copy_root->left;
+			root->height = copy_root->height; // a rank for WAVL, recomputed by AVL
+		}
+
+		RecycleNode(copy_root);
+		return root;
+	}
+
+	// Erase path[depth - 1], path[0] Being root: balances back up the path, no key is compared
+	template<typename T, typename T_Height, typename Augment, typename Balancing>
+	inline void AVLTree<T, T_Height, Augment, Balancing>::EraseAt(Node* const* path, std::size_t depth)
+	{
+		Node* subtree = Balance::balance(RemoveNode(path[depth - 1]));
+		for (std::size_t i = depth - 1; i-- > 0;)
+		{
+			Node* parent = path[i];
+			(parent->left == path[i + 1] ? parent->left : parent->right) = subtree;
+			subtree = Balance::balance(parent);
+		}
+
+		root = subtree;
+		--size_;
+		++version_;
+	}
+
+	// R || Order In (lo, hi), Balance Rule And size_l / size_r Of Every Node Below root
+	template<typename T, typename T_Height, typename Augment, typename Balancing>
+	inline bool AVLTree<T, T_Height, Augment, Balancing>::CheckSubtree(const Node* root, const T* lo, const T* hi, std::size_t& count)
+	{
+		count = 0;
+		if (root == nullptr)
+			return true;
+
+		if ((lo && !(*lo < root->data)) || (hi && !(root->data < *hi)))
+			return false;
+
+		std::size_t count_l, count_r;
+		if (!CheckSubtree(root->left, lo, &root->data, count_l) || !CheckSubtree(root->right, &root->data, hi, count_r))
+			return false;
+
+		count = count_l + count_r + 1;
+		return root->size_l == count_l && root->size_r == count_r && Balance::valid(root);
 	}
 
 	// R || Find Element
-	template<typename T, typename T_Height>
-	inline typename AVLTree<T, T_Height>::Node* AVLTree<T, T_Height>::find_(Node* root, const T& data) const
+	template<typename T, typename T_Height, typename Augment, typename Balancing>
+	inline typename AVLTree<T, T_Height, Augment, Balancing>::Node* AVLTree<T, T_Height, Augment, Balancing>::find_(Node* root, const T& data) const
 	{
 		if (root == nullptr)
 		{
@@ -655,10 +1638,236 @@ namespace Tree
 		}
 		else if (data > root->data)
 		{
-			return find_(root->right, data);
+			return find_(root->right, data);
+		}
+
+		return nullptr;
+	}
+
+	template<typename T, typename T_Height, typename Augment, typename Balancing>
+	inline void AVLTree<T, T_Height, Augment, Balancing>::Insert(const T& data, std::false_type)
+	{
+		root = insert_(root, data);
+	}
+
+	// Arithmetic Keys: descend recording the path, link, balance bottom-up
+	template<typename T, typename T_Height, typename Augment, typename Balancing>
+	inline void AVLTree<T, T_Height, Augment, Balancing>::Insert(const T& data, std::true_type)
+	{
+		Node* path[max_depth];
+		std::size_t depth = 0;
+		Node* current = root;
+		while (current != nullptr)
+		{
+			if (current->data == data)
+			{
+				isSuccessfully = false;
+				lastNode = current;
+				return;
+			}
+
+			path[depth++] = current;
+			if (data < current->data)
+				current = current->left;
+			else
+				current = current->right;
+		}
+
+		if (depth > 0)
+			Augment::place(path[depth - 1]);
+
+		Node* node = lastNode = NewNode(data);
+		if (depth == 0)
+		{
+			root = node;
+			return;
+		}
+
+		Node* parent = path[depth - 1];
+		(data > parent->data ? parent->right : parent->left) = node;
+
+		for (std::size_t i = depth; i-- > 0;)
+		{
+			Node* balanced = Balance::balance(path[i]);
+			if (balanced == path[i])
+				continue;
+
+			if (i == 0)
+				root = balanced;
+			else if (path[i - 1]->left == path[i])
+				path[i - 1]->left = balanced;
+			else
+				path[i - 1]->right = balanced;
+		}
+	}
+
+	template<typename T, typename T_Height, typename Augment, typename Balancing>
+	inline typename AVLTree<T, T_Height, Augment, Balancing>::Node* AVLTree<T, T_Height, Augment, Balancing>::Find(const T& data, std::false_type) const
+	{
+		return find_(root, data);
+	}
+
+	template<typename T, typename T_Height, typename Augment, typename Balancing>
+	inline typename AVLTree<T, T_Height, Augment, Balancing>::Node* AVLTree<T, T_Height, Augment, Balancing>::Find(const T& data, std::true_type) const
+	{
+		Node* current = root;
+		while (current != nullptr && current->data != data)
+		{
+			if (data < current->data)
+				current = current->left;
+			else
+				current = current->right;
+		}
+
+		return current;
+	}
+
+	// First Element >= data (or_equal == false: > data)
+	template<typename T, typename T_Height, typename Augment, typename Balancing>
+	inline const typename AVLTree<T, T_Height, Augment, Balancing>::Node* AVLTree<T, T_Height, Augment, Balancing>::LowerBound(const T& data, bool or_equal) const
+	{
+		const Node* current = root, * bound = nullptr;
+		while (current)
+		{
+			if (current->data < data || (!or_equal && current->data == data))
+				current = current->right;
+			else
+			{
+				bound = current;
+				current = current->left;
+			}
+		}
+
+		return bound;
+	}
+
+	// Number Of Elements < data (or_equal: <= data)
+	template<typename T, typename T_Height, typename Augment, typename Balancing>
+	inline std::size_t AVLTree<T, T_Height, Augment, Balancing>::Rank(const T& data, bool or_equal) const
+	{
+		std::size_t less = 0;
+		const Node* current = root;
+		while (current)
+		{
+			if (current->data < data || (or_equal && current->data == data))
+			{
+				less += current->size_l + 1;
+				current = current->right;
+			}
+			else
+				current = current->left;
+		}
+
+		return less;
+	}
+
+	// Element With index Smaller Elements
+	template<typename T, typename T_Height, typename Augment, typename Balancing>
+	inline const typename AVLTree<T, T_Height, Augment, Balancing>::Node* AVLTree<T, T_Height, Augment, Balancing>::Select(std::size_t index) const
+	{
+		const Node* current = root;
+		while (current && index != current->size_l)
+		{
+			if (index < current->size_l)
+				current = current->left;
+			else
+			{
+				index -= current->size_l + 1;
+				current = current->right;
+			}
+		}
+
+		return current;
+	}
+
+	// R || Rank Every Query Of [first, last) (sorted by key) In One Shared Descent; less = elements left of root
+	template<typename T, typename T_Height, typename Augment, typename Balancing>
+	inline void AVLTree<T, T_Height, Augment, Balancing>::RankBatch(const Node* root, RankQuery* first, RankQuery* last, std::size_t less)
+	{
+		while (first != last)
+		{
+			if (root == nullptr)
+			{
+				for (; first != last; ++first)
+				{
+					first->rank = less;
+					first->found = false;
+				}
+				return;
+			}
+
+			// [first, equal) < root->data, [equal, greater) == root->data, [greater, last) > root->data
+			RankQuery* equal = std::partition_point(first, last, [root](const RankQuery& query) { return *query.key < root->data; });
+			RankQuery* greater = std::partition_point(equal, last, [root](const RankQuery& query) { return !(root->data < *query.key); });
+
+			for (RankQuery* query = equal; query != greater; ++query)
+			{
+				query->rank = less + root->size_l;
+				query->found = true;
+			}
+
+			// recurse into the smaller side, loop on the other
+			if (equal - first < last - greater)
+			{
+				RankBatch(root->left, first, equal, less);
+				less += root->size_l + 1;
+				first = greater;
+				root = root->right;
+			}
+			else
+			{
+				RankBatch(root->right, greater, last, less + root->size_l + 1);
+				last = equal;
+				root = root->left;
+			}
+		}
+	}
+
+	// Move hint To data: Climb To The Nearest Ancestor Bounding data, Then Descend (nullptr if missing)
+	template<typename T, typename T_Height, typename Augment, typename Balancing>
+	inline typename AVLTree<T, T_Height, Augment, Balancing>::Node* AVLTree<T, T_Height, Augment, Balancing>::Seek(Finger& hint, const T& data) const
+	{
+		std::vector<typename Finger::Step>& path = hint.path;
+		if (hint.owner != this || hint.version != version_)
+		{
+			path.clear();
+			hint.owner = this;
+			hint.version = version_;
+		}
+
+		if (path.empty())
+		{
+			if (root == nullptr)
+				return nullptr;
+			path.push_back({ root, Finger::none, Finger::none });
+		}
+
+		// climb: one hop per bounding ancestor until data lies inside the subtree
+		for (;;)
+		{
+			const Node* current = path.back().node;
+			if (current->data == data)
+				return path.back().node;
+
+			bool greater = data > current->data;
+			std::size_t bound = (greater ? path.back().hi : path.back().lo);
+			if (bound == Finger::none || (greater ? data < path[bound].node->data : data > path[bound].node->data))
+				break;
+
+			path.resize(bound + 1);
 		}
 
-		return nullptr;
+		for (Node* current = path.back().node;;)
+		{
+			bool right = data > current->data;
+			current = (right ? current->right : current->left);
+			if (current == nullptr)
+				return nullptr;
+
+			hint.push(current, right);
+			if (current->data == data)
+				return current;
+		}
 	}
 
 	// _Private Methods
@@ -667,8 +1876,8 @@ namespace Tree
 	// Public Constructors
 	//
 
-	template<typename T, typename T_Height>
-	inline AVLTree<T, T_Height>::AVLTree(const std::initializer_list<T>& data)
+	template<typename T, typename T_Height, typename Augment, typename Balancing>
+	inline AVLTree<T, T_Height, Augment, Balancing>::AVLTree(const std::initializer_list<T>& data)
 		: root(nullptr)
 	{
 		for (const T& value : data)
@@ -677,70 +1886,128 @@ namespace Tree
 		}
 	}
 
-	template<typename T, typename T_Height>
-	inline AVLTree<T, T_Height>::AVLTree(const AVLTree<T, T_Height>& other)
-		: size_(other.size_)
+	template<typename T, typename T_Height, typename Augment, typename Balancing>
+	inline AVLTree<T, T_Height, Augment, Balancing>::AVLTree(const AVLTree<T, T_Height, Augment, Balancing>& other)
+		: root(nullptr), size_(other.size_)
 	{
-		root = CopyAVLTree(root, other.root);
+		std::vector<Node*> reuse;
+		root = CopyAVLTree(other.root, reuse);
 	}
 
-	template<typename T, typename T_Height>
-	inline AVLTree<T, T_Height>::AVLTree(AVLTree<T, T_Height>&& other)
-		: root(other.root), size_(other.size_)
+	template<typename T, typename T_Height, typename Augment, typename Balancing>
+	inline AVLTree<T, T_Height, Augment, Balancing>::AVLTree(AVLTree<T, T_Height, Augment, Balancing>&& other) noexcept
+		: root(other.root), size_(other.size_), layout_(std::move(other.layout_)),
+		free_(other.free_), free_count_(other.free_count_), reuse_(other.reuse_), graveyard_(other.graveyard_)
 	{
-		size_ = other.size_;
-		root = other.root;
 		other.root = nullptr;
+		other.size_ = 0;
+		other.free_ = nullptr;
+		other.free_count_ = 0;
+		other.graveyard_ = nullptr;
+		++other.version_; // fingers on other point at nodes this tree owns now
 	}
 
-	template<typename T, typename T_Height>
-	inline AVLTree<T, T_Height>& AVLTree<T, T_Height>::operator=(const AVLTree<T, T_Height>& other)
+	template<typename T, typename T_Height, typename Augment, typename Balancing>
+	inline AVLTree<T, T_Height, Augment, Balancing>& AVLTree<T, T_Height, Augment, Balancing>::operator=(const AVLTree<T, T_Height, Augment, Balancing>& other)
 	{
 		if (this != &other)
 		{
-			this->clear();
+			// the current nodes are overwritten in place, only the difference is allocated or freed
+			std::vector<Node*> reuse;
+			reuse.reserve(size_);
+			Flatten(root, reuse);
+
+			root = CopyAVLTree(other.root, reuse);
 			size_ = other.size_;
-			root = CopyAVLTree(root, other.root);
+			++version_;
+
+			for (Node* node : reuse)
+				RecycleNode(node);
 		}
 
 		return *this;
 	}
 
-	template<typename T, typename T_Height>
-	inline AVLTree<T, T_Height>& AVLTree<T, T_Height>::operator=(AVLTree<T, T_Height>&& other) noexcept
+	template<typename T, typename T_Height, typename Augment, typename Balancing>
+	inline AVLTree<T, T_Height, Augment, Balancing>& AVLTree<T, T_Height, Augment, Balancing>::operator=(AVLTree<T, T_Height, Augment, Balancing>&& other) noexcept
 	{
 		if (this != &other)
 		{
+			// spare and pending nodes may live in the blocks of the layout replaced below
 			this->clear();
+			this->clear_step(SIZE_MAX);
+			this->shrink_to_fit();
 
 			size_ = other.size_;
 			root = other.root;
 			other.root = nullptr;
+			other.size_ = 0;
+			layout_ = std::move(other.layout_);
+			std::swap(free_, other.free_);
+			std::swap(free_count_, other.free_count_);
+			std::swap(graveyard_, other.graveyard_);
+			reuse_ = other.reuse_;
+			++version_;
+			++other.version_;
 		}
 
 		return *this;
 	}
 
-	template<typename T, typename T_Height>
-	inline bool AVLTree<T, T_Height>::operator==(const AVLTree<T, T_Height>& other) const
+	template<typename T, typename T_Height, typename Augment, typename Balancing>
+	inline bool AVLTree<T, T_Height, Augment, Balancing>::operator==(const AVLTree<T, T_Height, Augment, Balancing>& other) const
 	{
-		isSuccessfully = (size_ == other.size_);
-		if (isSuccessfully)
-			IsEqual(root, other.root);
+		if (size_ != other.size_)
+			return false;
 
-		return isSuccessfully;
+		InOrder mine(root), others(other.root);
+		for (const Node* node = mine.next(); node != nullptr; node = mine.next())
+		{
+			if (node->data != others.next()->data)
+				return false;
+		}
+
+		return true;
 	}
 
-	template<typename T, typename T_Height>
-	inline bool AVLTree<T, T_Height>::operator!=(const AVLTree<T, T_Height>& other) const
+	template<typename T, typename T_Height, typename Augment, typename Balancing>
+	inline bool AVLTree<T, T_Height, Augment, Balancing>::operator!=(const AVLTree<T, T_Height, Augment, Balancing>& other) const
 	{
 		return !(*this == other);
 	}
 
-	template<typename T, typename T_Height>
-	inline AVLTree<T, T_Height>::~AVLTree()
+	template<typename T, typename T_Height, typename Augment, typename Balancing>
+	inline int AVLTree<T, T_Height, Augment, Balancing>::compare(const AVLTree<T, T_Height, Augment, Balancing>& other) const
+	{
+		InOrder mine(root), others(other.root);
+		while (true)
+		{
+			const Node* node = mine.next(), * other_node = others.next();
+			if (node == nullptr || other_node == nullptr)
+				return (node ? 1 : 0) - (other_node ? 1 : 0);
+
+			if (node->data < other_node->data)
+				return -1;
+			if (other_node->data < node->data)
+				return 1;
+		}
+	}
+
+#if ((defined(_MSVC_LANG) && _MSVC_LANG >= 202002L) || __cplusplus >= 202002L)
+	template<typename T, typename T_Height, typename Augment, typename Balancing>
+	inline std::weak_ordering AVLTree<T, T_Height, Augment, Balancing>::operator<=>(const AVLTree<T, T_Height, Augment, Balancing>& other) const
+	{
+		int result = compare(other);
+		return result < 0 ? std::weak_ordering::less : (result > 0 ? std::weak_ordering::greater : std::weak_ordering::equivalent);
+	}
+#endif
+
+	template<typename T, typename T_Height, typename Augment, typename Balancing>
+	inline AVLTree<T, T_Height, Augment, Balancing>::~AVLTree()
 	{
 		this->clear();
+		this->clear_step(SIZE_MAX);
+		this->shrink_to_fit();
 	}
 
 	// _Public Constructors
@@ -750,42 +2017,45 @@ namespace Tree
 	// Public Methods
 	//
 
-	template<typename T, typename T_Height>
-	inline bool AVLTree<T, T_Height>::insert(const T& data)
+	template<typename T, typename T_Height, typename Augment, typename Balancing>
+	inline bool AVLTree<T, T_Height, Augment, Balancing>::insert(const T& data)
 	{
 		isSuccessfully = true;
-		root = insert_(root, data);
+		Insert(data, scalar_key());
 		size_ += isSuccessfully;
+		version_ += isSuccessfully;
 		return isSuccessfully;
 	}
 
-	template<typename T, typename T_Height>
-	inline bool AVLTree<T, T_Height>::erase(const T& data)
+	template<typename T, typename T_Height, typename Augment, typename Balancing>
+	inline bool AVLTree<T, T_Height, Augment, Balancing>::erase(const T& data)
 	{
 		isSuccessfully = true;
 		root = erase_(root, data);
 		size_ -= isSuccessfully;
+		version_ += isSuccessfully;
 		return isSuccessfully;
 	}
 
-	template<typename T, typename T_Height>
-	inline const typename AVLTree<T, T_Height>::Node* AVLTree<T, T_Height>::find(const T& data) const&
+	template<typename T, typename T_Height, typename Augment, typename Balancing>
+	inline const typename AVLTree<T, T_Height, Augment, Balancing>::Node* AVLTree<T, T_Height, Augment, Balancing>::find(const T& data) const&
 	{
-		return find_(root, data);
+		return Find(data, scalar_key());
 	}
 
-	template<typename T, typename T_Height>
-	inline void AVLTree<T, T_Height>::clear()
+	template<typename T, typename T_Height, typename Augment, typename Balancing>
+	inline void AVLTree<T, T_Height, Augment, Balancing>::clear()
 	{
 		if (root != nullptr)
 		{
 			root = RemoveAllNode(root);
 			size_ = 0;
+			++version_;
 		}
 	}
 
-	template<typename T, typename T_Height>
-	inline void AVLTree<T, T_Height>::swap(Tree::AVLTree<T, T_Height>& AvlTree)
+	template<typename T, typename T_Height, typename Augment, typename Balancing>
+	inline void AVLTree<T, T_Height, Augment, Balancing>::swap(Tree::AVLTree<T, T_Height, Augment, Balancing>& AvlTree) noexcept
 	{
 		Node* copy_root = root;
 		root = AvlTree.root;
@@ -794,26 +2064,32 @@ namespace Tree
 		unsigned short copy_size = size_;
 		size_ = AvlTree.size_;
 		AvlTree.size_ = copy_size;
+
+		layout_.swap(AvlTree.layout_);
+		std::swap(free_, AvlTree.free_);
+		std::swap(free_count_, AvlTree.free_count_);
+		std::swap(reuse_, AvlTree.reuse_);
+		std::swap(graveyard_, AvlTree.graveyard_);
+
+		++version_;
+		++AvlTree.version_;
 	}
 
-	template<typename T, typename T_Height>
-	inline unsigned short AVLTree<T, T_Height>::size() const
+	template<typename T, typename T_Height, typename Augment, typename Balancing>
+	inline unsigned short AVLTree<T, T_Height, Augment, Balancing>::size() const
 	{
 		return size_;
 	}
 
-	template<typename T, typename T_Height>
-	inline unsigned int AVLTree<T, T_Height>::distance(const T& element1, const T& element2) const
+	template<typename T, typename T_Height, typename Augment, typename Balancing>
+	inline unsigned int AVLTree<T, T_Height, Augment, Balancing>::distance(const T& element1, const T& element2) const
 	{
 		if (element1 < element2)
 		{
 			Node* LCA = LCA_find(element1, element2, root);
 			if (LCA != nullptr)
 			{
-				isSuccessfully = true;
 				int l_dist = (LCA->data == element1 ? 0 : GetDistance(element1, LCA, false));
-
-				isSuccessfully = true;
 				int r_dist = (LCA->data == element2 ? 0 : GetDistance(element2, LCA, true));
 
 				return (l_dist < 0 || r_dist < 0) ? 0 : (l_dist + r_dist);
@@ -822,14 +2098,89 @@ namespace Tree
 		return 0;
 	}
 
+	template<typename T, typename T_Height, typename Augment, typename Balancing>
+	inline void AVLTree<T, T_Height, Augment, Balancing>::rank_batch(const std::vector<T>& sorted_keys, std::vector<std::size_t>& out) const
+	{
+		out.resize(sorted_keys.size());
+		if (!std::is_sorted(sorted_keys.begin(), sorted_keys.end()))
+		{
+			for (std::size_t i = 0; i < sorted_keys.size(); ++i)
+				out[i] = Rank(sorted_keys[i], false);
+			return;
+		}
+
+		std::vector<RankQuery> queries(sorted_keys.size());
+		for (std::size_t i = 0; i < sorted_keys.size(); ++i)
+			queries[i].key = &sorted_keys[i];
+
+		RankBatch(root, queries.data(), queries.data() + queries.size(), 0);
+		for (std::size_t i = 0; i < queries.size(); ++i)
+			out[i] = queries[i].rank;
+	}
+
+	template<typename T, typename T_Height, typename Augment, typename Balancing>
+	inline void AVLTree<T, T_Height, Augment, Balancing>::distance_batch(const std::vector<std::pair<T, T>>& pairs, std::vector<unsigned int>& out) const
+	{
+		// first and second endpoints ranked apart: pairs sorted by first need no sort on that side
+		std::vector<RankQuery> firsts(pairs.size()), seconds(pairs.size());
+		for (std::size_t i = 0; i < pairs.size(); ++i)
+		{
+			firsts[i].key = &pairs[i].first;
+			firsts[i].index = i;
+			seconds[i].key = &pairs[i].second;
+			seconds[i].index = i;
+		}
+
+		std::vector<std::size_t> ranks[2];
+		std::vector<char> found[2];
+		std::vector<RankQuery>* sides[2] = { &firsts, &seconds };
+		auto by_key = [](const RankQuery& lhs, const RankQuery& rhs) { return *lhs.key < *rhs.key; };
+		for (int side = 0; side < 2; ++side)
+		{
+			std::vector<RankQuery>& queries = *sides[side];
+			if (!std::is_sorted(queries.begin(), queries.end(), by_key))
+				std::sort(queries.begin(), queries.end(), by_key);
+			RankBatch(root, queries.data(), queries.data() + queries.size(), 0);
+
+			ranks[side].resize(queries.size());
+			found[side].resize(queries.size());
+			for (const RankQuery& query : queries)
+			{
+				ranks[side][query.index] = query.rank;
+				found[side][query.index] = query.found;
+			}
+		}
+
+		// same answer as distance(): rank difference of two present elements, first < second
+		out.resize(pairs.size());
+		for (std::size_t i = 0; i < pairs.size(); ++i)
+		{
+			bool valid = found[0][i] && found[1][i] && pairs[i].first < pairs[i].second;
+			out[i] = valid ? static_cast<unsigned int>(ranks[1][i] - ranks[0][i]) : 0u;
+		}
+	}
+
+	template<typename T, typename T_Height, typename Augment, typename Balancing>
+	inline const typename AVLTree<T, T_Height, Augment, Balancing>::Node* AVLTree<T, T_Height, Augment, Balancing>::select(std::size_t index) const
+	{
+		return Select(index);
+	}
+
+	template<typename T, typename T_Height, typename Augment, typename Balancing>
+	inline bool AVLTree<T, T_Height, Augment, Balancing>::check_invariants() const
+	{
+		std::size_t count;
+		return CheckSubtree(root, nullptr, nullptr, count) && count == size_;
+	}
+
 	// _Public Methods
 
 	//
 	// iterator
 	//
 
-	template<typename T, typename T_Height>
-	inline const T& AVLTree<T, T_Height>::Iterator::operator*() const noexcept(false)
+	template<typename T, typename T_Height, typename Augment, typename Balancing>
+	inline const T& AVLTree<T, T_Height, Augment, Balancing>::Iterator::operator*() const noexcept(false)
 	{
 		if (flag != ittype::def)
 			throw std::out_of_range("Out of range");
@@ -837,8 +2188,8 @@ namespace Tree
 		return current->data;
 	}
 
-	template<typename T, typename T_Height>
-	inline typename AVLTree<T, T_Height>::Iterator& AVLTree<T, T_Height>::Iterator::operator++() noexcept(false)
+	template<typename T, typename T_Height, typename Augment, typename Balancing>
+	inline typename AVLTree<T, T_Height, Augment, Balancing>::Iterator& AVLTree<T, T_Height, Augment, Balancing>::Iterator::operator++() noexcept(false)
 	{
 		if (flag == ittype::end)
 			throw std::out_of_range("Out of range");
@@ -862,8 +2213,8 @@ namespace Tree
 		return *this;
 	}
 
-	template<typename T, typename T_Height>
-	inline typename AVLTree<T, T_Height>::Iterator AVLTree<T, T_Height>::Iterator::operator++(int) noexcept(false)
+	template<typename T, typename T_Height, typename Augment, typename Balancing>
+	inline typename AVLTree<T, T_Height, Augment, Balancing>::Iterator AVLTree<T, T_Height, Augment, Balancing>::Iterator::operator++(int) noexcept(false)
 	{
 		iterator copy_iter = *this;
 
@@ -889,8 +2240,8 @@ namespace Tree
 		return copy_iter;
 	}
 
-	template<typename T, typename T_Height>
-	inline typename AVLTree<T, T_Height>::Iterator& AVLTree<T, T_Height>::Iterator::operator--() noexcept(false)
+	template<typename T, typename T_Height, typename Augment, typename Balancing>
+	inline typename AVLTree<T, T_Height, Augment, Balancing>::Iterator& AVLTree<T, T_Height, Augment, Balancing>::Iterator::operator--() noexcept(false)
 	{
 		if (flag == ittype::end)
 		{
@@ -914,8 +2265,8 @@ namespace Tree
 		return *this;
 	}
 
-	template<typename T, typename T_Height>
-	inline typename AVLTree<T, T_Height>::Iterator AVLTree<T, T_Height>::Iterator::operator--(int) noexcept(false)
+	template<typename T, typename T_Height, typename Augment, typename Balancing>
+	inline typename AVLTree<T, T_Height, Augment, Balancing>::Iterator AVLTree<T, T_Height, Augment, Balancing>::Iterator::operator--(int) noexcept(false)
 	{
 		iterator copy_iter = *this;
 
@@ -941,8 +2292,8 @@ namespace Tree
 		return copy_iter;
 	}
 
-	template<typename T, typename T_Height>
-	inline bool AVLTree<T, T_Height>::Iterator::operator==(const Iterator& other) const
+	template<typename T, typename T_Height, typename Augment, typename Balancing>
+	inline bool AVLTree<T, T_Height, Augment, Balancing>::Iterator::operator==(const Iterator& other) const
 	{
 		if (other.flag != flag && (other.flag == ittype::err || flag == ittype::err))
 			throw std::invalid_argument("Invalid compare");
@@ -950,14 +2301,14 @@ namespace Tree
 		return (other.current == current && other.flag == flag);
 	}
 
-	template<typename T, typename T_Height>
-	inline bool AVLTree<T, T_Height>::Iterator::operator!=(const Iterator& other) const
+	template<typename T, typename T_Height, typename Augment, typename Balancing>
+	inline bool AVLTree<T, T_Height, Augment, Balancing>::Iterator::operator!=(const Iterator& other) const
 	{
 		return !(other == *this);
 	}
 
-	template<typename T, typename T_Height>
-	inline const T* AVLTree<T, T_Height>::Iterator::operator->() const
+	template<typename T, typename T_Height, typename Augment, typename Balancing>
+	inline const T* AVLTree<T, T_Height, Augment, Balancing>::Iterator::operator->() const
 	{
 		if (flag != ittype::def)
 			throw std::out_of_range("Out of range");
@@ -967,8 +2318,8 @@ namespace Tree
 
 	// iterator
 
-	template<typename T, typename T_Height>
-	inline typename AVLTree<T, T_Height>::iterator AVLTree<T, T_Height>::begin() const
+	template<typename T, typename T_Height, typename Augment, typename Balancing>
+	inline typename AVLTree<T, T_Height, Augment, Balancing>::iterator AVLTree<T, T_Height, Augment, Balancing>::begin() const
 	{
 		if (root)
 			return iterator(GetMinElement(root), root, ittype::def);
@@ -976,8 +2327,8 @@ namespace Tree
 		return end();
 	}
 
-	template<typename T, typename T_Height>
-	inline typename AVLTree<T, T_Height>::iterator AVLTree<T, T_Height>::end() const
+	template<typename T, typename T_Height, typename Augment, typename Balancing>
+	inline typename AVLTree<T, T_Height, Augment, Balancing>::iterator AVLTree<T, T_Height, Augment, Balancing>::end() const
 	{
 		return iterator(nullptr, root, ittype::end);
 	}
@@ -986,14 +2337,14 @@ namespace Tree
 
 	// сonst_iterator
 
-	template<typename T, typename T_Height>
-	inline typename AVLTree<T, T_Height>::const_iterator AVLTree<T, T_Height>::cbegin() const
+	template<typename T, typename T_Height, typename Augment, typename Balancing>
+	inline typename AVLTree<T, T_Height, Augment, Balancing>::const_iterator AVLTree<T, T_Height, Augment, Balancing>::cbegin() const
 	{
 		return begin();
 	}
 
-	template<typename T, typename T_Height>
-	inline typename AVLTree<T, T_Height>::const_iterator AVLTree<T, T_Height>::cend() const
+	template<typename T, typename T_Height, typename Augment, typename Balancing>
+	inline typename AVLTree<T, T_Height, Augment, Balancing>::const_iterator AVLTree<T, T_Height, Augment, Balancing>::cend() const
 	{
 		return end();
 	}
@@ -1004,29 +2355,536 @@ namespace Tree
 	// 
 	// reverse_iterator + const_reverse_iterator
 	// 
-	template<typename T, typename T_Height>
-	inline std::reverse_iterator<typename AVLTree<T, T_Height>::iterator> AVLTree<T, T_Height>::rbegin() const
+	template<typename T, typename T_Height, typename Augment, typename Balancing>
+	inline std::reverse_iterator<typename AVLTree<T, T_Height, Augment, Balancing>::iterator> AVLTree<T, T_Height, Augment, Balancing>::rbegin() const
 	{
 		return std::reverse_iterator<iterator>(end());
 	}
 
-	template<typename T, typename T_Height>
-	inline std::reverse_iterator<typename AVLTree<T, T_Height>::const_iterator> AVLTree<T, T_Height>::crbegin() const
+	template<typename T, typename T_Height, typename Augment, typename Balancing>
+	inline std::reverse_iterator<typename AVLTree<T, T_Height, Augment, Balancing>::const_iterator> AVLTree<T, T_Height, Augment, Balancing>::crbegin() const
 	{
 		return std::reverse_iterator<iterator>(cend());
 	}
 
-	template<typename T, typename T_Height>
-	inline std::reverse_iterator<typename AVLTree<T, T_Height>::iterator> AVLTree<T, T_Height>::rend() const
+	template<typename T, typename T_Height, typename Augment, typename Balancing>
+	inline std::reverse_iterator<typename AVLTree<T, T_Height, Augment, Balancing>::iterator> AVLTree<T, T_Height, Augment, Balancing>::rend() const
 	{
 		return std::reverse_iterator<iterator>(begin());
 	}
 
-	template<typename T, typename T_Height>
-	inline std::reverse_iterator<typename AVLTree<T, T_Height>::const_iterator> AVLTree<T, T_Height>::crend() const
+	template<typename T, typename T_Height, typename Augment, typename Balancing>
+	inline std::reverse_iterator<typename AVLTree<T, T_Height, Augment, Balancing>::const_iterator> AVLTree<T, T_Height, Augment, Balancing>::crend() const
 	{
 		return std::reverse_iterator<iterator>(cbegin());
 	}
 
 	// _reverse_iterator
+
+	//
+	// cursor
+	//
+
+	template<typename T, typename T_Height, typename Augment, typename Balancing>
+	inline AVLTree<T, T_Height, Augment, Balancing>::Cursor::Cursor(const Node* current, const Node* root) noexcept
+		: root(root)
+	{
+		for (const Node* node = root; current != nullptr; node = current->data < node->data ? node->left : node->right)
+		{
+			path[depth++] = node;
+			if (node == current)
+				break;
+		}
+	}
+
+	template<typename T, typename T_Height, typename Augment, typename Balancing>
+	inline void AVLTree<T, T_Height, Augment, Balancing>::Cursor::Descend(const Node* node, bool left) noexcept
+	{
+		for (; node != nullptr; node = left ? node->left : node->right)
+			path[depth++] = node;
+	}
+
+	template<typename T, typename T_Height, typename Augment, typename Balancing>
+	inline typename AVLTree<T, T_Height, Augment, Balancing>::Cursor& AVLTree<T, T_Height, Augment, Balancing>::Cursor::operator++() noexcept
+	{
+		const Node* node = path[depth - 1];
+		if (node->right)
+		{
+			Descend(node->right, true);
+		}
+		else
+		{
+			// climb while coming from a right child: the first parent reached from the left is next
+			while (--depth != 0 && path[depth - 1]->right == node)
+				node = path[depth - 1];
+		}
+
+		return *this;
+	}
+
+	template<typename T, typename T_Height, typename Augment, typename Balancing>
+	inline typename AVLTree<T, T_Height, Augment, Balancing>::Cursor AVLTree<T, T_Height, Augment, Balancing>::Cursor::operator++(int) noexcept
+	{
+		Cursor copy_cursor = *this;
+		++*this;
+		return copy_cursor;
+	}
+
+	template<typename T, typename T_Height, typename Augment, typename Balancing>
+	inline typename AVLTree<T, T_Height, Augment, Balancing>::Cursor& AVLTree<T, T_Height, Augment, Balancing>::Cursor::operator--() noexcept
+	{
+		if (depth == 0)
+		{
+			Descend(root, false);
+		}
+		else if (path[depth - 1]->left)
+		{
+			Descend(path[depth - 1]->left, false);
+		}
+		else
+		{
+			const Node* node = path[depth - 1];
+			while (--depth != 0 && path[depth - 1]->left == node)
+				node = path[depth - 1];
+		}
+
+		return *this;
+	}
+
+	template<typename T, typename T_Height, typename Augment, typename Balancing>
+	inline typename AVLTree<T, T_Height, Augment, Balancing>::Cursor AVLTree<T, T_Height, Augment, Balancing>::Cursor::operator--(int) noexcept
+	{
+		Cursor copy_cursor = *this;
+		--*this;
+		return copy_cursor;
+	}
+
+	template<typename T, typename T_Height, typename Augment, typename Balancing>
+	inline typename AVLTree<T, T_Height, Augment, Balancing>::cursor AVLTree<T, T_Height, Augment, Balancing>::cursor_begin() const noexcept
+	{
+		const Node* current = root;
+		while (current && current->left)
+			current = current->left;
+
+		return cursor(current, root);
+	}
+
+	template<typename T, typename T_Height, typename Augment, typename Balancing>
+	inline typename AVLTree<T, T_Height, Augment, Balancing>::cursor AVLTree<T, T_Height, Augment, Balancing>::cursor_end() const noexcept
+	{
+		return cursor(nullptr, root);
+	}
+
+	// _cursor
+
+	//
+	// views
+	//
+
+	template<typename T, typename T_Height, typename Augment, typename Balancing>
+	inline typename AVLTree<T, T_Height, Augment, Balancing>::range_type AVLTree<T, T_Height, Augment, Balancing>::range(const T& lo, const T& hi) const
+	{
+		if (hi < lo)
+			return range_type(cursor_end(), cursor_end(), 0);
+
+		return range_type(cursor(LowerBound(lo, true), root), cursor(LowerBound(hi, false), root), Rank(hi, true) - Rank(lo, false));
+	}
+
+	template<typename T, typename T_Height, typename Augment, typename Balancing>
+	inline typename AVLTree<T, T_Height, Augment, Balancing>::reverse_range_type AVLTree<T, T_Height, Augment, Balancing>::reverse_range(const T& lo, const T& hi) const
+	{
+		range_type forward = range(lo, hi);
+		return reverse_range_type(std::reverse_iterator<cursor>(forward.end()), std::reverse_iterator<cursor>(forward.begin()), forward.size());
+	}
+
+	template<typename T, typename T_Height, typename Augment, typename Balancing>
+	inline std::vector<typename AVLTree<T, T_Height, Augment, Balancing>::range_type> AVLTree<T, T_Height, Augment, Balancing>::split_range(std::size_t parts) const
+	{
+		std::vector<range_type> ranges;
+		if (root == nullptr)
+			return ranges;
+
+		return split_range(GetMinElement(root)->data, GetMaxElement(root)->data, parts);
+	}
+
+	template<typename T, typename T_Height, typename Augment, typename Balancing>
+	inline std::vector<typename AVLTree<T, T_Height, Augment, Balancing>::range_type> AVLTree<T, T_Height, Augment, Balancing>::split_range(const T& lo, const T& hi, std::size_t parts) const
+	{
+		std::vector<range_type> ranges;
+		if (parts == 0 || hi < lo)
+			return ranges;
+
+		std::size_t first = Rank(lo, false), last = Rank(hi, true);
+		std::size_t count = last - first;
+		if (parts > count)
+			parts = (count ? count : 1);
+
+		ranges.reserve(parts);
+		const Node* begin_node = Select(first);
+		for (std::size_t part = 1; part <= parts; ++part)
+		{
+			std::size_t end_rank = first + count * part / parts;
+			const Node* end_node = Select(end_rank);
+			std::size_t begin_rank = first + count * (part - 1) / parts;
+			ranges.emplace_back(cursor(begin_rank == end_rank ? end_node : begin_node, root), cursor(end_node, root), end_rank - begin_rank);
+			begin_node = end_node;
+		}
+
+		return ranges;
+	}
+
+	// _views
+
+	//
+	// bulk export
+	//
+
+	// In-Order Walk Of [*lo, *hi] With An Explicit Stack + Prefetch Of The Right Children
+	template<typename T, typename T_Height, typename Augment, typename Balancing>
+	template<typename F>
+	inline void AVLTree<T, T_Height, Augment, Balancing>::Scan(const Node* root, const T* lo, const T* hi, F visit)
+	{
+		const Node* stack[max_depth];
+		std::size_t depth = 0;
+
+		// lower bound: nodes under lo are passed on the right, the others wait on the stack
+		for (const Node* node = root; node != nullptr;)
+		{
+			if (lo && node->data < *lo)
+				node = node->right;
+			else
+			{
+				AVLTREE_PREFETCH(node->right);
+				stack[depth++] = node;
+				node = node->left;
+			}
+		}
+
+		while (depth > 0)
+		{
+			const Node* node = stack[--depth];
+			if (hi && *hi < node->data)
+				return;
+			if (!visit(node->data))
+				return;
+
+			for (node = node->right; node != nullptr; node = node->left)
+			{
+				AVLTREE_PREFETCH(node->right);
+				stack[depth++] = node;
+			}
+		}
+	}
+
+	template<typename T, typename T_Height, typename Augment, typename Balancing>
+	template<typename OutputIt>
+	inline OutputIt AVLTree<T, T_Height, Augment, Balancing>::copy_to(OutputIt out) const
+	{
+		Scan(root, nullptr, nullptr, [&out](const T& data) {
+			*out = data;
+			++out;
+			return true;
+		});
+
+		return out;
+	}
+
+	template<typename T, typename T_Height, typename Augment, typename Balancing>
+	template<typename F>
+	inline void AVLTree<T, T_Height, Augment, Balancing>::for_each(F visitor) const
+	{
+		Scan(root, nullptr, nullptr, [&visitor](const T& data) {
+			visitor(data);
+			return true;
+		});
+	}
+
+	template<typename T, typename T_Height, typename Augment, typename Balancing>
+	inline std::size_t AVLTree<T, T_Height, Augment, Balancing>::export_range(const T& lo, const T& hi, T* buf, std::size_t n) const
+	{
+		std::size_t written = 0;
+		if (n == 0 || hi < lo)
+			return written;
+
+		Scan(root, &lo, &hi, [&](const T& data) {
+			buf[written++] = data;
+			return written < n;
+		});
+
+		return written;
+	}
+
+	// _bulk export
+
+	//
+	// node reuse
+	//
+
+	template<typename T, typename T_Height, typename Augment, typename Balancing>
+	inline void AVLTree<T, T_Height, Augment, Balancing>::reuse_nodes(bool on)
+	{
+		reuse_ = on;
+		if (!on)
+			shrink_to_fit();
+	}
+
+	template<typename T, typename T_Height, typename Augment, typename Balancing>
+	inline void AVLTree<T, T_Height, Augment, Balancing>::reserve(std::size_t n)
+	{
+		reuse_ = true;
+		n = std::min<std::size_t>(n, USHRT_MAX);
+		// straight onto the free list: during a compact_step() pass RecycleNode() deletes
+		while (size_ + free_count_ < n)
+		{
+			Node* node = new Node(T());
+			node->right = free_;
+			free_ = node;
+			++free_count_;
+		}
+	}
+
+	template<typename T, typename T_Height, typename Augment, typename Balancing>
+	inline void AVLTree<T, T_Height, Augment, Balancing>::shrink_to_fit()
+	{
+		while (free_ != nullptr)
+		{
+			Node* node = free_;
+			free_ = node->right;
+			DeleteNode(node);
+		}
+		free_count_ = 0;
+	}
+
+	template<typename T, typename T_Height, typename Augment, typename Balancing>
+	inline std::size_t AVLTree<T, T_Height, Augment, Balancing>::capacity() const
+	{
+		return size_ + free_count_;
+	}
+
+	// _node reuse
+
+	//
+	// stepwise descent
+	//
+
+	template<typename T, typename T_Height, typename Augment, typename Balancing>
+	inline const typename AVLTree<T, T_Height, Augment, Balancing>::Node* AVLTree<T, T_Height, Augment, Balancing>::descent_begin() const noexcept
+	{
+		return root;
+	}
+
+	template<typename T, typename T_Height, typename Augment, typename Balancing>
+	inline const typename AVLTree<T, T_Height, Augment, Balancing>::Node* AVLTree<T, T_Height, Augment, Balancing>::descent_next(const Node* node, const T& data)
+	{
+		return data < node->data ? node->left : node->right;
+	}
+
+	// _stepwise descent
+
+	//
+	// incremental destruction
+	//
+
+	template<typename T, typename T_Height, typename Augment, typename Balancing>
+	inline AVLTree<T, T_Height, Augment, Balancing> AVLTree<T, T_Height, Augment, Balancing>::detach()
+	{
+		AVLTree<T, T_Height, Augment, Balancing> detached(std::move(*this));
+		++version_;
+		return detached;
+	}
+
+	template<typename T, typename T_Height, typename Augment, typename Balancing>
+	inline bool AVLTree<T, T_Height, Augment, Balancing>::clear_step(std::size_t budget)
+	{
+		if (graveyard_ == nullptr && root != nullptr)
+		{
+			graveyard_ = root;
+			root = nullptr;
+			size_ = 0;
+			++version_;
+		}
+
+		// a left child is rotated up (no stack), a node without one is freed: each step is O(1)
+		for (; budget > 0 && graveyard_ != nullptr; --budget)
+		{
+			Node* node = graveyard_;
+			if (node->left != nullptr)
+			{
+				graveyard_ = node->left;
+				node->left = graveyard_->right;
+				graveyard_->right = node;
+			}
+			else
+			{
+				graveyard_ = node->right;
+				RecycleNode(node);
+			}
+		}
+
+		return graveyard_ == nullptr;
+	}
+
+	// _incremental destruction
+
+	// finger search
+
+	template<typename T, typename T_Height, typename Augment, typename Balancing>
+	inline const typename AVLTree<T, T_Height, Augment, Balancing>::Node* AVLTree<T, T_Height, Augment, Balancing>::find_from(finger& hint, const T& data) const
+	{
+		return Seek(hint, data);
+	}
+
+	template<typename T, typename T_Height, typename Augment, typename Balancing>
+	inline bool AVLTree<T, T_Height, Augment, Balancing>::insert_near(finger& hint, const T& data)
+	{
+		Node* match = Seek(hint, data);
+		if (match != nullptr)
+		{
+			lastNode = match;
+			return false;
+		}
+
+		std::vector<typename Finger::Step>& path = hint.path;
+		if (!path.empty())
+			Augment::place(path.back().node);
+
+		Node* node = lastNode = NewNode(data);
+		if (path.empty())
+		{
+			root = node;
+			path.push_back({ node, Finger::none, Finger::none });
+			++size_;
+			hint.version = ++version_;
+			return true;
+		}
+
+		Node* parent = path.back().node;
+		bool right = data > parent->data;
+		(right ? parent->right : parent->left) = node;
+
+		// bottom-up balance; AVL / WAVL inserts rotate at most once, below the highest rotation the path is taken again
+		std::size_t rotated = path.size();
+		for (std::size_t i = path.size(); i-- > 0;)
+		{
+			Node* current = path[i].node;
+			Node* balanced = Balance::balance(current);
+			if (balanced != current)
+			{
+				if (i == 0)
+					root = balanced;
+				else if (path[i - 1].node->left == current)
+					path[i - 1].node->left = balanced;
+				else
+					path[i - 1].node->right = balanced;
+
+				path[i].node = balanced; // same key range, same bounds
+				rotated = i;
+			}
+		}
+
+		if (rotated < path.size())
+		{
+			path.resize(rotated + 1);
+			for (Node* current = path.back().node; current != node;)
+			{
+				right = data > current->data;
+				current = (right ? current->right : current->left);
+				hint.push(current, right);
+			}
+		}
+		else
+			hint.push(node, right);
+
+		++size_;
+		hint.version = ++version_;
+		return true;
+	}
+
+	// _finger search
+
+	// memory layout
+
+	template<typename T, typename T_Height, typename Augment, typename Balancing>
+	inline void AVLTree<T, T_Height, Augment, Balancing>::compact()
+	{
+		while (!compact_step(static_cast<std::size_t>(-1)));
+	}
+
+	template<typename T, typename T_Height, typename Augment, typename Balancing>
+	inline bool AVLTree<T, T_Height, Augment, Balancing>::compact_step(std::size_t budget)
+	{
+		if (!layout_)
+			layout_.reset(new Layout());
+
+		Layout& layout = *layout_;
+		if (!layout.active)
+		{
+			if (root == nullptr)
+				return true;
+
+			typename Layout::Block block;
+			block.nodes = static_cast<Node*>(::operator new(size_ * sizeof(Node)));
+			block.capacity = size_;
+			layout.blocks.push_back(block);
+			layout.queue.reserve(2 * static_cast<std::size_t>(size_) + 1); // no regrowth inside a step
+			layout.queue.assign(1, typename Layout::Link{ nullptr, false });
+			layout.head = 0;
+			layout.dead.assign(size_, false);
+			layout.active = true;
+		}
+
+		// links stay valid across insert/erase between steps: a node linked after its parent
+		// was walked is left where it is (the next pass takes it), no node is moved twice
+		std::size_t moved = 0;
+		for (std::size_t visited = 0; visited < budget && layout.head < layout.queue.size(); ++visited)
+		{
+			const typename Layout::Link link = layout.queue[layout.head++];
+
+			// DeleteNode() may free an emptied older block, the target stays last
+			typename Layout::Block& target = layout.blocks.back();
+			if (link.owner != nullptr && layout.dead[link.owner - target.nodes])
+				continue;
+
+			Node*& child = (link.owner == nullptr ? root : link.right ? link.owner->right : link.owner->left);
+			Node* node = child;
+			if (node == nullptr || target.owns(node) || target.used == target.capacity)
+				continue;
+
+			Node* copy = ::new (target.nodes + target.used++) Node(std::move(node->data));
+			copy->left = node->left;
+			copy->right = node->right;
+			copy->height = node->height;
+			copy->size_l = node->size_l;
+			copy->size_r = node->size_r;
+			static_cast<Augment&>(*copy) = static_cast<const Augment&>(*node);
+			++target.live;
+
+			if (lastNode == node)
+				lastNode = copy;
+			child = copy;
+			DeleteNode(node);
+			++moved;
+
+			layout.queue.push_back(typename Layout::Link{ copy, false });
+			layout.queue.push_back(typename Layout::Link{ copy, true });
+		}
+
+		if (moved != 0)
+			++version_; // fingers hold node addresses
+
+		if (layout.head < layout.queue.size())
+			return false;
+
+		layout.active = false;
+		layout.queue = std::vector<typename Layout::Link>();
+		layout.dead = std::vector<bool>();
+		if (layout.blocks.back().live == 0)
+		{
+			::operator delete(layout.blocks.back().nodes);
+			layout.blocks.pop_back();
+		}
+		return true;
+	}
+
+	// _memory layout
 }
\ No newline at end of file
@@ -0,0 +1,701 @@
+#pragma once
+#include "AVLTree.hpp"
+#include <algorithm>
+#include <iterator>
+#include <vector>
+
+namespace Tree
+{
+	// AVL Tree Of Sorted Blocks: every node holds up to BlockSize keys, at least half of that once there
+	// are two blocks (T must be default-constructible)
+	template<typename T, unsigned char BlockSize = 32, typename T_Height = unsigned char>
+	class BlockAVLTree
+	{
+		static_assert(BlockSize >= 2, "a block must hold at least two keys");
+
+	private: // Block
+		// Node Augmentation: number of keys in the subtree
+		struct CountAugment : NoAugment
+		{
+			unsigned int total = 0;
+
+			template<typename Node>
+			static void update(Node* root)
+			{
+				root->total = root->count + (root->left ? root->left->total : 0) + (root->right ? root->right->total : 0);
+			}
+		};
+
+		struct Block : CountAugment
+		{
+			T keys[BlockSize];
+			Block* left = nullptr;
+			Block* right = nullptr;
+			T_Height height = 1;
+			unsigned short size_r = 0, size_l = 0; // in blocks
+			unsigned char count = 0;
+		};
+
+		using Balance = AVLBalance<Block, T_Height, CountAugment>;
+
+		Block* root = nullptr;
+		mutable bool isSuccessfully = true;
+		unsigned int blocks_ = 0;
+		Block* underfull = nullptr; // block erase_() left under half full
+
+		// Iterators
+
+		//
+		// iterator
+		//
+
+		// _iterator
+		class Iterator
+		{
+		private:
+			std::vector<const Block*> path; // back() = current block
+			unsigned char index = 0;
+
+			void PushLeft(const Block* root);
+
+		public:
+			using value_type = T;
+			using difference_type = std::ptrdiff_t;
+			using pointer = const T*;
+			using reference = const T&;
+			using iterator_category = std::forward_iterator_tag;
+
+			Iterator() = default;
+			explicit Iterator(const Block* root) { PushLeft(root); }
+
+			const T& operator*() const { return path.back()->keys[index]; }
+			const T* operator->() const { return &path.back()->keys[index]; }
+
+			Iterator& operator++();
+			Iterator operator++(int);
+
+			bool operator==(const Iterator& other) const;
+			bool operator!=(const Iterator& other) const;
+		};
+		// _iterators
+
+		// Methods
+
+		// Index Of The First Key >= data (linear scan, blocks are small)
+		static unsigned char LowerBound(const Block* block, const T& data);
+
+		// Number Of Keys In The Subtree
+		static unsigned int total(const Block* root);
+
+		// Link A New Block As Minimal Element + Balance
+		Block* LinkMin(Block* root, Block* block);
+
+		// Split A Full Block, Upper Half Becomes Its Successor Block
+		Block* SplitInsert(Block* root, const T& data);
+
+		// Block Holding The Next (next) Or Previous Keys Of block (nullptr: none)
+		Block* Neighbour(const Block* block, bool next) const;
+
+		// Take root Out, Its Successor Takes Its Place (not deleted, not balanced)
+		static Block* Unlink(Block* root);
+
+		// R || Unlink block (found by its keys) + Balance
+		static Block* Detach(Block* root, Block* block);
+
+		// R || Recompute Key Counts On The Path To The Block Holding key
+		static void Recount(Block* root, const T& key);
+
+		// Merge An Underfull Block Into Its Neighbour, Or Even Out Their Keys
+		void Refill(Block* block);
+
+		Block* RemoveAllBlocks(Block* root);
+		Block* CopyBlocks(const Block* other_root);
+
+		// R || Insert Element + Balance
+		Block* insert_(Block* root, const T& data);
+
+		// R || Erase Element + Balance
+		Block* erase_(Block* root, const T& data);
+
+		// R || In-Order Walk
+		template<typename Visitor>
+		static void for_each_(const Block* root, Visitor& visit);
+
+		// _Private Methods
+	public: // Constructors
+		BlockAVLTree() = default;
+		BlockAVLTree(const std::initializer_list<T>& init_list);
+
+		BlockAVLTree(const BlockAVLTree& other);
+		BlockAVLTree(BlockAVLTree&& other) noexcept;
+
+		BlockAVLTree& operator=(const BlockAVLTree& other);
+		BlockAVLTree& operator=(BlockAVLTree&& other) noexcept;
+
+		~BlockAVLTree();
+	public: // Methods
+		bool insert(const T& data);
+		bool erase(const T& data);
+		const T* find(const T& data) const;
+		void clear();
+		unsigned int size() const;
+
+		// Number Of Keys Less Than data
+		unsigned int rank(const T& data) const;
+
+		unsigned int distance(const T& element1, const T& element2) const;
+
+		// Number Of Blocks (memory = block_count() * block_bytes())
+		unsigned int block_count() const;
+		static constexpr std::size_t block_bytes() { return sizeof(Block); }
+
+		// Visit Keys In Order, Block By Block
+		template<typename Visitor>
+		void for_each(Visitor visit) const;
+
+	public: // iterators
+		using iterator = Iterator;
+		using const_iterator = Iterator;
+
+		NODISCARD iterator begin() const;
+		NODISCARD iterator end() const;
+	};
+
+	//
+	// iterator
+	//
+
+	template<typename T, unsigned char BlockSize, typename T_Height>
+	inline void BlockAVLTree<T, BlockSize, T_Height>::Iterator::PushLeft(const Block* root)
+	{
+		for (; root; root = root->left)
+			path.push_back(root);
+
+		index = 0;
+	}
+
+	template<typename T, unsigned char BlockSize, typename T_Height>
+	inline typename BlockAVLTree<T, BlockSize, T_Height>::Iterator& BlockAVLTree<T, BlockSize, T_Height>::Iterator::operator++()
+	{
+		if (++index == path.back()->count)
+		{
+			const Block* done = path.back();
+			path.pop_back();
+			PushLeft(done->right);
+		}
+
+		return *this;
+	}
+
+	template<typename T, unsigned char BlockSize, typename T_Height>
+	inline typename BlockAVLTree<T, BlockSize, T_Height>::Iterator BlockAVLTree<T, BlockSize, T_Height>::Iterator::operator++(int)
+	{
+		Iterator copy_iter = *this;
+		++*this;
+		return copy_iter;
+	}
+
+	template<typename T, unsigned char BlockSize, typename T_Height>
+	inline bool BlockAVLTree<T, BlockSize, T_Height>::Iterator::operator==(const Iterator& other) const
+	{
+		if (path.empty() || other.path.empty())
+			return path.empty() && other.path.empty();
+
+		return path.back() == other.path.back() && index == other.index;
+	}
+
+	template<typename T, unsigned char BlockSize, typename T_Height>
+	inline bool BlockAVLTree<T, BlockSize, T_Height>::Iterator::operator!=(const Iterator& other) const
+	{
+		return !(*this == other);
+	}
+
+	// _iterator
+
+	//
+	// Private Methods
+	//
+
+	// Index Of The First Key >= data
+	template<typename T, unsigned char BlockSize, typename T_Height>
+	inline unsigned char BlockAVLTree<T, BlockSize, T_Height>::LowerBound(const Block* block, const T& data)
+	{
+		unsigned char index = 0;
+		while (index < block->count && block->keys[index] < data)
+			++index;
+
+		return index;
+	}
+
+	template<typename T, unsigned char BlockSize, typename T_Height>
+	inline unsigned int BlockAVLTree<T, BlockSize, T_Height>::total(const Block* root)
+	{
+		return root ? root->total : 0;
+	}
+
+	// Link A New Block As Minimal Element + Balance
+	template<typename T, unsigned char BlockSize, typename T_Height>
+	inline typename BlockAVLTree<T, BlockSize, T_Height>::Block* BlockAVLTree<T, BlockSize, T_Height>::LinkMin(Block* root, Block* block)
+	{
+		if (root == nullptr)
+		{
+			Balance::update(block);
+			return block;
+		}
+
+		root->left = LinkMin(root->left, block);
+		return Balance::balance(root);
+	}
+
+	// Split A Full Block, Upper Half Becomes Its Successor Block
+	template<typename T, unsigned char BlockSize, typename T_Height>
+	inline typename BlockAVLTree<T, BlockSize, T_Height>::Block* BlockAVLTree<T, BlockSize, T_Height>::SplitInsert(Block* root, const T& data)
+	{
+		Block* upper = new Block();
+		++blocks_;
+
+		const unsigned char half = BlockSize / 2;
+		std::move(root->keys + half, root->keys + BlockSize, upper->keys);
+		upper->count = BlockSize - half;
+		root->count = half;
+
+		Block* target = (data < upper->keys[0] ? root : upper);
+		unsigned char index = LowerBound(target, data);
+		std::move_backward(target->keys + index, target->keys + target->count, target->keys + target->count + 1);
+		target->keys[index] = data;
+		++target->count;
+
+		root->right = LinkMin(root->right, upper);
+		return root;
+	}
+
+	// Block Holding The Next (next) Or Previous Keys Of block (nullptr: none)
+	template<typename T, unsigned char BlockSize, typename T_Height>
+	inline typename BlockAVLTree<T, BlockSize, T_Height>::Block* BlockAVLTree<T, BlockSize, T_Height>::Neighbour(const Block* block, bool next) const
+	{
+		Block* candidate = nullptr; // last ancestor passed on the side of the neighbour
+		Block* current = root;
+		while (current != block)
+		{
+			if (block->keys[0] < current->keys[0])
+			{
+				if (next)
+					candidate = current;
+				current = current->left;
+			}
+			else
+			{
+				if (!next)
+					candidate = current;
+				current = current->right;
+			}
+		}
+
+		Block* child = next ? block->right : block->left;
+		if (child == nullptr)
+			return candidate;
+
+		while (Block* inner = (next ? child->left : child->right))
+			child = inner;
+		return child;
+	}
+
+	// Take root Out, Its Successor Takes Its Place (not deleted, not balanced)
+	template<typename T, unsigned char BlockSize, typename T_Height>
+	inline typename BlockAVLTree<T, BlockSize, T_Height>::Block* BlockAVLTree<T, BlockSize, T_Height>::Unlink(Block* root)
+	{
+		if (root->right == nullptr)
+			return root->left;
+
+		Block* minroot = Balance::GetMinElement(root->right);
+		if (minroot != root->right)
+			minroot->right = Balance::RemBalMin(root->right, minroot);
+		minroot->left = root->left;
+		return minroot;
+	}
+
+	// R || Unlink block (found by its keys) + Balance
+	template<typename T, unsigned char BlockSize, typename T_Height>
+	inline typename BlockAVLTree<T, BlockSize, T_Height>::Block* BlockAVLTree<T, BlockSize, T_Height>::Detach(Block* root, Block* block)
+	{
+		if (root == block)
+			root = Unlink(root);
+		else if (block->keys[0] < root->keys[0])
+			root->left = Detach(root->left, block);
+		else
+			root->right = Detach(root->right, block);
+
+		return Balance::balance(root);
+	}
+
+	// R || Recompute Key Counts On The Path To The Block Holding key
+	template<typename T, unsigned char BlockSize, typename T_Height>
+	inline void BlockAVLTree<T, BlockSize, T_Height>::Recount(Block* root, const T& key)
+	{
+		if (root == nullptr)
+			return;
+
+		if (key < root->keys[0])
+			Recount(root->left, key);
+		else if (key > root->keys[root->count - 1])
+			Recount(root->right, key);
+
+		Balance::update(root);
+	}
+
+	// Merge An Underfull Block Into Its Neighbour, Or Even Out Their Keys
+	template<typename T, unsigned char BlockSize, typename T_Height>
+	inline void BlockAVLTree<T, BlockSize, T_Height>::Refill(Block* block)
+	{
+		Block* next = Neighbour(block, true);
+		Block* lower = (next ? block : Neighbour(block, false));
+		Block* upper = (next ? next : block);
+		if (lower == nullptr) // the only block
+			return;
+
+		if (lower->count + upper->count <= BlockSize)
+		{
+			root = Detach(root, upper);
+			std::move(upper->keys, upper->keys + upper->count, lower->keys + lower->count);
+			lower->count += upper->count;
+			delete upper;
+			--blocks_;
+			Recount(root, lower->keys[0]);
+			return;
+		}
+
+		// too many keys for one block: both end at least half full
+		const unsigned char keep = static_cast<unsigned char>((lower->count + upper->count) / 2);
+		if (lower->count < keep)
+		{
+			const unsigned char moved = keep - lower->count;
+			std::move(upper->keys, upper->keys + moved, lower->keys + lower->count);
+			std::move(upper->keys + moved, upper->keys + upper->count, upper->keys);
+			upper->count -= moved;
+		}
+		else
+		{
+			const unsigned char moved = lower->count - keep;
+			std::move_backward(upper->keys, upper->keys + upper->count, upper->keys + upper->count + moved);
+			std::move(lower->keys + keep, lower->keys + lower->count, upper->keys);
+			upper->count += moved;
+		}
+		lower->count = keep;
+
+		Recount(root, lower->keys[0]);
+		Recount(root, upper->keys[0]);
+	}
+
+	template<typename T, unsigned char BlockSize, typename T_Height>
+	inline typename BlockAVLTree<T, BlockSize, T_Height>::Block* BlockAVLTree<T, BlockSize, T_Height>::RemoveAllBlocks(Block* root)
+	{
+		while (root)
+		{
+			RemoveAllBlocks(root->left);
+			Block* right = root->right;
+			delete root;
+			root = right;
+		}
+
+		return nullptr;
+	}
+
+	template<typename T, unsigned char BlockSize, typename T_Height>
+	inline typename BlockAVLTree<T, BlockSize, T_Height>::Block* BlockAVLTree<T, BlockSize, T_Height>::CopyBlocks(const Block* other_root)
+	{
+		if (other_root == nullptr)
+		{
+			return nullptr;
+		}
+
+		Block* root = new Block(*other_root);
+		root->left = CopyBlocks(other_root->left);
+		root->right = CopyBlocks(other_root->right);
+
+		return root;
+	}
+
+	// R || Insert Element + Balance
+	template<typename T, unsigned char BlockSize, typename T_Height>
+	inline typename BlockAVLTree<T, BlockSize, T_Height>::Block* BlockAVLTree<T, BlockSize, T_Height>::insert_(Block* root, const T& data)
+	{
+		if (root == nullptr)
+		{
+			Block* block = new Block();
+			++blocks_;
+			block->keys[0] = data;
+			block->count = 1;
+			Balance::update(block);
+			return block;
+		}
+		else if (data < root->keys[0] && root->left)
+		{
+			root->left = insert_(root->left, data);
+		}
+		else if (data > root->keys[root->count - 1] && root->right)
+		{
+			root->right = insert_(root->right, data);
+		}
+		else // data belongs to this block
+		{
+			unsigned char index = LowerBound(root, data);
+			if (index < root->count && root->keys[index] == data)
+			{
+				isSuccessfully = false;
+				return root;
+			}
+
+			if (root->count == BlockSize)
+			{
+				root = SplitInsert(root, data);
+			}
+			else
+			{
+				std::move_backward(root->keys + index, root->keys + root->count, root->keys + root->count + 1);
+				root->keys[index] = data;
+				++root->count;
+			}
+		}
+
+		return isSuccessfully ? Balance::balance(root) : root;
+	}
+
+	// R || Erase Element + Balance
+	template<typename T, unsigned char BlockSize, typename T_Height>
+	inline typename BlockAVLTree<T, BlockSize, T_Height>::Block* BlockAVLTree<T, BlockSize, T_Height>::erase_(Block* root, const T& data)
+	{
+		if (root == nullptr)
+		{
+			isSuccessfully = false;
+			return nullptr;
+		}
+		else if (data < root->keys[0])
+		{
+			root->left = erase_(root->left, data);
+		}
+		else if (data > root->keys[root->count - 1])
+		{
+			root->right = erase_(root->right, data);
+		}
+		else
+		{
+			unsigned char index = LowerBound(root, data);
+			if (index == root->count || root->keys[index] != data)
+			{
+				isSuccessfully = false;
+				return root;
+			}
+
+			std::move(root->keys + index + 1, root->keys + root->count, root->keys + index);
+			--root->count;
+
+			if (root->count == 0) // unlink the empty block, its successor takes its place
+			{
+				Block* copy_root = root;
+				root = Unlink(root);
+				delete copy_root;
+				--blocks_;
+			}
+			else if (root->count < BlockSize / 2)
+			{
+				underfull = root;
+			}
+		}
+
+		return isSuccessfully ? Balance::balance(root) : root;
+	}
+
+	// R || In-Order Walk
+	template<typename T, unsigned char BlockSize, typename T_Height>
+	template<typename Visitor>
+	inline void BlockAVLTree<T, BlockSize, T_Height>::for_each_(const Block* root, Visitor& visit)
+	{
+		while (root)
+		{
+			for_each_(root->left, visit);
+			for (const T* key = root->keys; key != root->keys + root->count; ++key)
+				visit(*key);
+			root = root->right;
+		}
+	}
+
+	// _Private Methods
+
+	//
+	// Public Constructors
+	//
+
+	template<typename T, unsigned char BlockSize, typename T_Height>
+	inline BlockAVLTree<T, BlockSize, T_Height>::BlockAVLTree(const std::initializer_list<T>& init_list)
+	{
+		for (const T& value : init_list)
+		{
+			insert(value);
+		}
+	}
+
+	template<typename T, unsigned char BlockSize, typename T_Height>
+	inline BlockAVLTree<T, BlockSize, T_Height>::BlockAVLTree(const BlockAVLTree& other)
+		: root(CopyBlocks(other.root)), blocks_(other.blocks_)
+	{ }
+
+	template<typename T, unsigned char BlockSize, typename T_Height>
+	inline BlockAVLTree<T, BlockSize, T_Height>::BlockAVLTree(BlockAVLTree&& other) noexcept
+		: root(other.root), blocks_(other.blocks_)
+	{
+		other.root = nullptr;
+		other.blocks_ = 0;
+	}
+
+	template<typename T, unsigned char BlockSize, typename T_Height>
+	inline BlockAVLTree<T, BlockSize, T_Height>& BlockAVLTree<T, BlockSize, T_Height>::operator=(const BlockAVLTree& other)
+	{
+		if (this != &other)
+		{
+			clear();
+			root = CopyBlocks(other.root);
+			blocks_ = other.blocks_;
+		}
+
+		return *this;
+	}
+
+	template<typename T, unsigned char BlockSize, typename T_Height>
+	inline BlockAVLTree<T, BlockSize, T_Height>& BlockAVLTree<T, BlockSize, T_Height>::operator=(BlockAVLTree&& other) noexcept
+	{
+		if (this != &other)
+		{
+			clear();
+			root = other.root;
+			blocks_ = other.blocks_;
+			other.root = nullptr;
+			other.blocks_ = 0;
+		}
+
+		return *this;
+	}
+
+	template<typename T, unsigned char BlockSize, typename T_Height>
+	inline BlockAVLTree<T, BlockSize, T_Height>::~BlockAVLTree()
+	{
+		clear();
+	}
+
+	// _Public Constructors
+
+	//
+	// Public Methods
+	//
+
+	template<typename T, unsigned char BlockSize, typename T_Height>
+	inline bool BlockAVLTree<T, BlockSize, T_Height>::insert(const T& data)
+	{
+		isSuccessfully = true;
+		root = insert_(root, data);
+		return isSuccessfully;
+	}
+
+	template<typename T, unsigned char BlockSize, typename T_Height>
+	inline bool BlockAVLTree<T, BlockSize, T_Height>::erase(const T& data)
+	{
+		isSuccessfully = true;
+		underfull = nullptr;
+		root = erase_(root, data);
+
+		// every block but a lone one stays at least half full
+		if (underfull != nullptr)
+			Refill(underfull);
+		return isSuccessfully;
+	}
+
+	template<typename T, unsigned char BlockSize, typename T_Height>
+	inline const T* BlockAVLTree<T, BlockSize, T_Height>::find(const T& data) const
+	{
+		const Block* current = root;
+		while (current)
+		{
+			if (data < current->keys[0])
+				current = current->left;
+			else if (data > current->keys[current->count - 1])
+				current = current->right;
+			else
+			{
+				unsigned char index = LowerBound(current, data);
+				return current->keys[index] == data ? &current->keys[index] : nullptr;
+			}
+		}
+
+		return nullptr;
+	}
+
+	template<typename T, unsigned char BlockSize, typename T_Height>
+	inline void BlockAVLTree<T, BlockSize, T_Height>::clear()
+	{
+		root = RemoveAllBlocks(root);
+		blocks_ = 0;
+	}
+
+	template<typename T, unsigned char BlockSize, typename T_Height>
+	inline unsigned int BlockAVLTree<T, BlockSize, T_Height>::size() const
+	{
+		return total(root);
+	}
+
+	template<typename T, unsigned char BlockSize, typename T_Height>
+	inline unsigned int BlockAVLTree<T, BlockSize, T_Height>::rank(const T& data) const
+	{
+		unsigned int less = 0;
+		const Block* current = root;
+		while (current)
+		{
+			if (data < current->keys[0])
+				current = current->left;
+			else if (data > current->keys[current->count - 1])
+			{
+				less += total(current->left) + current->count;
+				current = current->right;
+			}
+			else
+				return less + total(current->left) + LowerBound(current, data);
+		}
+
+		return less;
+	}
+
+	template<typename T, unsigned char BlockSize, typename T_Height>
+	inline unsigned int BlockAVLTree<T, BlockSize, T_Height>::distance(const T& element1, const T& element2) const
+	{
+		if (element1 < element2 && find(element1) && find(element2))
+		{
+			return rank(element2) - rank(element1);
+		}
+		return 0;
+	}
+
+	template<typename T, unsigned char BlockSize, typename T_Height>
+	inline unsigned int BlockAVLTree<T, BlockSize, T_Height>::block_count() const
+	{
+		return blocks_;
+	}
+
+	template<typename T, unsigned char BlockSize, typename T_Height>
+	template<typename Visitor>
+	inline void BlockAVLTree<T, BlockSize, T_Height>::for_each(Visitor visit) const
+	{
+		for_each_(root, visit);
+	}
+
+	template<typename T, unsigned char BlockSize, typename T_Height>
+	inline typename BlockAVLTree<T, BlockSize, T_Height>::iterator BlockAVLTree<T, BlockSize, T_Height>::begin() const
+	{
+		return iterator(root);
+	}
+
+	template<typename T, unsigned char BlockSize, typename T_Height>
+	inline typename BlockAVLTree<T, BlockSize, T_Height>::iterator BlockAVLTree<T, BlockSize, T_Height>::end() const
+	{
+		return iterator();
+	}
+
+	// _Public Methods
+}
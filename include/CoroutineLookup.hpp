@@ -0,0 +1,238 @@
+#pragma once
+#include "AVLTree.hpp"
+
+// C++20 coroutines: nothing is declared below C++20 (the library itself stays C++14)
+#if ((defined(_MSVC_LANG) && _MSVC_LANG >= 202002L) || __cplusplus >= 202002L) && defined(__cpp_impl_coroutine)
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <utility>
+#include <vector>
+
+namespace Tree
+{
+	// Recycled Coroutine Frames Of This Thread: a scheduler keeps at most width lookups alive,
+	// so after the first ones no frame is allocated
+	class LookupFrames
+	{
+	private:
+		std::size_t bytes = 0; // frame size of find_async(), known from the first frame
+		std::vector<void*> spare;
+
+		static LookupFrames& Local()
+		{
+			thread_local LookupFrames frames;
+			return frames;
+		}
+
+	public:
+		~LookupFrames()
+		{
+			for (void* frame : spare)
+				::operator delete(frame);
+		}
+
+		static void* allocate(std::size_t bytes)
+		{
+			LookupFrames& frames = Local();
+			if (bytes == frames.bytes && !frames.spare.empty())
+			{
+				void* frame = frames.spare.back();
+				frames.spare.pop_back();
+				return frame;
+			}
+			return ::operator new(bytes);
+		}
+
+		static void deallocate(void* frame, std::size_t bytes) noexcept
+		{
+			LookupFrames& frames = Local();
+			if (frames.bytes == 0)
+				frames.bytes = bytes;
+
+			if (bytes == frames.bytes && frames.spare.size() < 1024)
+			{
+				try
+				{
+					frames.spare.push_back(frame);
+					return;
+				}
+				catch (...)
+				{
+				}
+			}
+			::operator delete(frame);
+		}
+	};
+
+	// One find() As A Coroutine: every resume() is one level of the descent (driven by LookupScheduler or by hand)
+	template<typename Node>
+	class LookupTask
+	{
+	public:
+		struct promise_type
+		{
+			const Node* result = nullptr;
+			std::exception_ptr error; // thrown by a comparison, rethrown by result()
+
+			LookupTask get_return_object() noexcept { return LookupTask(std::coroutine_handle<promise_type>::from_promise(*this)); }
+			std::suspend_always initial_suspend() noexcept { return {}; }
+			std::suspend_always final_suspend() noexcept { return {}; }
+			void return_value(const Node* node) noexcept { result = node; }
+			void unhandled_exception() noexcept { error = std::current_exception(); }
+
+			static void* operator new(std::size_t bytes) { return LookupFrames::allocate(bytes); }
+			static void operator delete(void* frame, std::size_t bytes) noexcept { LookupFrames::deallocate(frame, bytes); }
+		};
+
+	private:
+		std::coroutine_handle<promise_type> handle;
+
+	public: // Constructors
+		LookupTask() = default;
+		explicit LookupTask(std::coroutine_handle<promise_type> handle) noexcept : handle(handle) { }
+
+		LookupTask(const LookupTask&) = delete;
+		LookupTask& operator=(const LookupTask&) = delete;
+
+		LookupTask(LookupTask&& other) noexcept : handle(std::exchange(other.handle, nullptr)) { }
+		LookupTask& operator=(LookupTask&& other) noexcept
+		{
+			if (this != &other)
+			{
+				if (handle)
+					handle.destroy();
+				handle = std::exchange(other.handle, nullptr);
+			}
+			return *this;
+		}
+
+		~LookupTask()
+		{
+			if (handle)
+				handle.destroy();
+		}
+
+	public: // Methods
+		bool done() const noexcept { return !handle || handle.done(); }
+
+		// Compare At The Node Prefetched Last Time, Prefetch The Next One, Suspend
+		void resume() { handle.resume(); }
+
+		// The Node Found (nullptr: missing), Once done()
+		const Node* result() const
+		{
+			if (handle.promise().error)
+				std::rethrow_exception(handle.promise().error);
+			return handle.promise().result;
+		}
+	};
+
+	// find() That Prefetches Each Node And Suspends Before Reading It, So Other Lookups Run While The
+	// Line Comes In. The tree must outlive the task and must not change while it runs
+	template<typename T, typename T_Height, typename Augment, typename Balancing>
+	LookupTask<typename AVLTree<T, T_Height, Augment, Balancing>::Node> find_async(const AVLTree<T, T_Height, Augment, Balancing>& tree, T data)
+	{
+		using tree_type = AVLTree<T, T_Height, Augment, Balancing>;
+		for (const typename tree_type::Node* node = tree.descent_begin(); node != nullptr; node = tree_type::descent_next(node, data))
+		{
+			AVLTREE_PREFETCH(node);
+			co_await std::suspend_always();
+
+			if (node->data == data)
+				co_return node;
+		}
+
+		co_return nullptr;
+	}
+
+	// Interleaves Up To width Lookups On One Thread: each pass resumes every lookup in flight for one level
+	// of its descent, so width cache misses overlap instead of stalling one after the other
+	template<typename TreeType>
+	class LookupScheduler
+	{
+	public:
+		using Node = typename TreeType::Node;
+		using key_type = decltype(std::declval<Node>().data);
+
+	private:
+		struct Request
+		{
+			const TreeType* tree;
+			key_type key;
+			const Node** out;
+		};
+
+		struct Slot
+		{
+			LookupTask<Node> task;
+			const Node** out;
+		};
+
+		std::vector<Request> requests;
+		std::vector<Slot> slots;
+		std::size_t width;
+
+		Slot Start(const Request& request) { return Slot{ find_async(*request.tree, request.key), request.out }; }
+
+	public: // Constructors
+		explicit LookupScheduler(std::size_t width = 32) : width(width == 0 ? 1 : width) { }
+
+	public: // Methods
+		// Queue A Lookup, *out Is Set By run()
+		void submit(const TreeType& tree, const key_type& key, const Node** out)
+		{
+			requests.push_back(Request{ &tree, key, out });
+		}
+
+		std::size_t pending() const noexcept { return requests.size(); }
+
+		// Run Every Queued Lookup, Round-Robin, A Finished Slot Taking The Next Request
+		void run()
+		{
+			std::size_t next = 0;
+			slots.clear();
+			while (slots.size() < width && next < requests.size())
+				slots.push_back(Start(requests[next++]));
+
+			while (!slots.empty())
+			{
+				for (std::size_t i = 0; i < slots.size();)
+				{
+					slots[i].task.resume();
+					if (!slots[i].task.done())
+					{
+						++i;
+						continue;
+					}
+
+					*slots[i].out = slots[i].task.result();
+					if (next < requests.size())
+						slots[i++] = Start(requests[next++]);
+					else
+					{
+						// the last slot moves in and is resumed at i
+						if (i + 1 != slots.size())
+							slots[i] = std::move(slots.back());
+						slots.pop_back();
+					}
+				}
+			}
+
+			requests.clear();
+		}
+	};
+
+	// out[i] = tree.find(keys[i]) With Up To width Descents Interleaved
+	template<typename T, typename T_Height, typename Augment, typename Balancing>
+	void find_interleaved(const AVLTree<T, T_Height, Augment, Balancing>& tree, const std::vector<T>& keys,
+		std::vector<const typename AVLTree<T, T_Height, Augment, Balancing>::Node*>& out, std::size_t width = 32)
+	{
+		LookupScheduler<AVLTree<T, T_Height, Augment, Balancing>> scheduler(width);
+		out.assign(keys.size(), nullptr);
+		for (std::size_t i = 0; i < keys.size(); ++i)
+			scheduler.submit(tree, keys[i], &out[i]);
+		scheduler.run();
+	}
+}
+#endif
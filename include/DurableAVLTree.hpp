@@ -0,0 +1,440 @@
+#pragma once
+#include "AVLTree.hpp"
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+#if defined(_WIN32)
+#include <io.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace Tree
+{
+	// Durability Knobs Of DurableAVLTree
+	struct DurableOptions
+	{
+		// records per group commit (one write + one fsync); 1 = every insert/erase is durable on return
+		std::size_t batch = 64;
+
+		// a buffered record is committed at the latest on the first write after this much time (zero: no limit)
+		std::chrono::milliseconds sync_interval = std::chrono::milliseconds(10);
+
+		// log records between two snapshots (0 = only checkpoint() writes one)
+		std::size_t checkpoint_every = 100000;
+	};
+
+	// What The Constructor Found On Disk
+	struct RecoveryStats
+	{
+		std::size_t snapshot_elements = 0; // loaded from the snapshot
+		std::size_t log_records = 0;       // replayed from the log tail
+		std::size_t dropped_bytes = 0;     // torn or corrupt log tail, ignored
+	};
+
+	// AVLTree Persisted In directory (must exist): snapshot + write-ahead log of every successful insert/erase.
+	// T is written byte for byte (trivially copyable); the tree is rebuilt from both at construction
+	template<typename T, typename T_Height = unsigned char>
+	class DurableAVLTree : protected AVLTree<T, T_Height>
+	{
+		static_assert(std::is_trivially_copyable<T>::value, "DurableAVLTree writes keys byte for byte");
+
+	private:
+		using Base = AVLTree<T, T_Height>;
+		using clock = std::chrono::steady_clock;
+
+		static constexpr std::uint32_t snapshot_magic = 0x53565441; // "ATVS"
+		static constexpr std::uint32_t log_magic = 0x4c565441;      // "ATVL"
+		static constexpr std::size_t record_bytes = 1 + sizeof(T) + 4; // op, key, checksum
+
+		// fclose() On Every Path Out, Errors Included
+		struct CloseFile
+		{
+			void operator()(std::FILE* file) const { std::fclose(file); }
+		};
+		using File = std::unique_ptr<std::FILE, CloseFile>;
+
+		std::string directory;
+		DurableOptions options;
+		RecoveryStats recovery;
+
+		File log;
+		std::uint64_t generation = 0;    // shared by the snapshot and the log that continues it
+		std::vector<char> buffer;        // records not written yet
+		std::size_t buffered = 0;
+		std::size_t since_checkpoint = 0;
+		clock::time_point oldest;        // first buffered record
+
+		std::string path(const char* name) const { return directory + "/" + name; }
+
+		// FNV-1a
+		static std::uint32_t Checksum(const char* data, std::size_t size, std::uint32_t hash = 2166136261u);
+
+		// Checksum Of The Snapshot Header Fields After The Magic
+		static std::uint32_t HeaderChecksum(std::uint64_t generation, std::uint64_t count);
+
+		// fflush + fsync (the data is on the device when it returns)
+		static void SyncFile(std::FILE* file);
+
+		// fsync Of The Directory Entry After A rename()
+		void SyncDirectory() const;
+
+		// Load snapshot + Replay The Log Of The Same Generation
+		void Recover();
+
+		// Start An Empty Log For generation (written aside, then renamed over the old one)
+		void OpenLog();
+
+		void Append(char op, const T& data);
+
+		// Write + fsync The Buffered Records (one group commit)
+		void Commit();
+
+	public:
+		using Node = typename Base::Node;
+		using iterator = typename Base::iterator;
+		using const_iterator = typename Base::const_iterator;
+
+	public: // Constructors
+		explicit DurableAVLTree(const std::string& directory, DurableOptions options = DurableOptions());
+
+		// the files belong to one tree
+		DurableAVLTree(const DurableAVLTree&) = delete;
+		DurableAVLTree& operator=(const DurableAVLTree&) = delete;
+
+		// Commits What Is Buffered
+		~DurableAVLTree();
+
+	public: // Methods
+		// Insert + Log (durable after the group commit it falls into, or sync())
+		bool insert(const T& data);
+		bool erase(const T& data);
+
+		// Commit Every Buffered Record Now
+		void sync();
+
+		// Write A Snapshot Of The Whole Tree And Start An Empty Log
+		void checkpoint();
+
+		// Records Accepted But Not Yet fsync'ed
+		std::size_t pending() const;
+
+		const RecoveryStats& recovered() const;
+
+		using Base::find;
+		using Base::size;
+		using Base::distance;
+		using Base::begin;
+		using Base::end;
+		using Base::cbegin;
+		using Base::cend;
+	};
+
+	//
+	// Private Methods
+	//
+
+	// FNV-1a
+	template<typename T, typename T_Height>
+	inline std::uint32_t DurableAVLTree<T, T_Height>::Checksum(const char* data, std::size_t size, std::uint32_t hash)
+	{
+		for (std::size_t i = 0; i < size; ++i)
+			hash = (hash ^ static_cast<unsigned char>(data[i])) * 16777619u;
+
+		return hash;
+	}
+
+	// Checksum Of The Snapshot Header Fields After The Magic
+	template<typename T, typename T_Height>
+	inline std::uint32_t DurableAVLTree<T, T_Height>::HeaderChecksum(std::uint64_t generation, std::uint64_t count)
+	{
+		return Checksum(reinterpret_cast<const char*>(&count), sizeof(count), Checksum(reinterpret_cast<const char*>(&generation), sizeof(generation)));
+	}
+
+	// fflush + fsync (the data is on the device when it returns)
+	template<typename T, typename T_Height>
+	inline void DurableAVLTree<T, T_Height>::SyncFile(std::FILE* file)
+	{
+		if (std::fflush(file) != 0)
+			throw std::runtime_error("DurableAVLTree: write failed");
+#if defined(_WIN32)
+		if (_commit(_fileno(file)) != 0)
+#else
+		if (fsync(fileno(file)) != 0)
+#endif
+			throw std::runtime_error("DurableAVLTree: fsync failed");
+	}
+
+	// fsync Of The Directory Entry After A rename()
+	template<typename T, typename T_Height>
+	inline void DurableAVLTree<T, T_Height>::SyncDirectory() const
+	{
+#if !defined(_WIN32)
+		int fd = open(directory.c_str(), O_RDONLY);
+		if (fd >= 0)
+		{
+			fsync(fd);
+			close(fd);
+		}
+#endif
+	}
+
+	// Load snapshot + Replay The Log Of The Same Generation
+	template<typename T, typename T_Height>
+	inline void DurableAVLTree<T, T_Height>::Recover()
+	{
+		if (File snapshot = File(std::fopen(path("snapshot").c_str(), "rb")))
+		{
+			// the header has its own checksum: a corrupt count must not size the key buffer
+			std::uint32_t magic = 0, header_checksum = 0, checksum = 0;
+			std::uint64_t count = 0;
+			bool ok = std::fread(&magic, sizeof(magic), 1, snapshot.get()) == 1 && magic == snapshot_magic
+				&& std::fread(&generation, sizeof(generation), 1, snapshot.get()) == 1
+				&& std::fread(&count, sizeof(count), 1, snapshot.get()) == 1
+				&& std::fread(&header_checksum, sizeof(header_checksum), 1, snapshot.get()) == 1
+				&& header_checksum == HeaderChecksum(generation, count) && count <= USHRT_MAX;
+
+			std::vector<T> keys(ok ? static_cast<std::size_t>(count) : 0);
+			ok = ok && std::fread(keys.data(), sizeof(T), keys.size(), snapshot.get()) == keys.size()
+				&& std::fread(&checksum, sizeof(checksum), 1, snapshot.get()) == 1
+				&& checksum == Checksum(reinterpret_cast<const char*>(keys.data()), keys.size() * sizeof(T));
+			snapshot.reset();
+
+			// the snapshot is renamed into place only once complete, so a bad one is not a torn write
+			if (!ok)
+				throw std::runtime_error("DurableAVLTree: corrupt snapshot in " + directory);
+
+			std::vector<std::pair<T, bool>> ops;
+			ops.reserve(keys.size());
+			for (const T& key : keys)
+				ops.emplace_back(key, true);
+			Base::MergeSorted(ops);
+			recovery.snapshot_elements = keys.size();
+		}
+
+		if (File old = File(std::fopen(path("log").c_str(), "rb")))
+		{
+			std::uint32_t magic = 0;
+			std::uint64_t log_generation = 0;
+			bool ok = std::fread(&magic, sizeof(magic), 1, old.get()) == 1 && magic == log_magic
+				&& std::fread(&log_generation, sizeof(log_generation), 1, old.get()) == 1;
+
+			// an older log was already folded into the snapshot (crash between the two renames)
+			if (ok && log_generation == generation)
+			{
+				char record[record_bytes];
+				std::size_t read;
+				while ((read = std::fread(record, 1, record_bytes, old.get())) == record_bytes)
+				{
+					std::uint32_t checksum;
+					std::memcpy(&checksum, record + 1 + sizeof(T), sizeof(checksum));
+					if (checksum != Checksum(record, 1 + sizeof(T)) || (record[0] != 'I' && record[0] != 'E'))
+						break;
+
+					T data;
+					std::memcpy(&data, record + 1, sizeof(T));
+					if (record[0] == 'I')
+						Base::insert(data);
+					else
+						Base::erase(data);
+					++recovery.log_records;
+				}
+
+				// everything after the last good record is the tail of an interrupted commit
+				long good = static_cast<long>(sizeof(magic) + sizeof(log_generation) + recovery.log_records * record_bytes);
+				std::fseek(old.get(), 0, SEEK_END);
+				recovery.dropped_bytes = static_cast<std::size_t>(std::ftell(old.get()) - good);
+			}
+		}
+	}
+
+	// Start An Empty Log For generation (written aside, then renamed over the old one)
+	template<typename T, typename T_Height>
+	inline void DurableAVLTree<T, T_Height>::OpenLog()
+	{
+		log.reset();
+
+		File fresh(std::fopen(path("log.tmp").c_str(), "wb"));
+		if (fresh == nullptr)
+			throw std::runtime_error("DurableAVLTree: cannot create log in " + directory);
+
+		std::uint32_t magic = log_magic;
+		std::fwrite(&magic, sizeof(magic), 1, fresh.get());
+		std::fwrite(&generation, sizeof(generation), 1, fresh.get());
+		SyncFile(fresh.get());
+		fresh.reset();
+
+		if (std::rename(path("log.tmp").c_str(), path("log").c_str()) != 0)
+			throw std::runtime_error("DurableAVLTree: cannot rename log in " + directory);
+		SyncDirectory();
+
+		log.reset(std::fopen(path("log").c_str(), "ab"));
+		if (log == nullptr)
+			throw std::runtime_error("DurableAVLTree: cannot open log in " + directory);
+	}
+
+	template<typename T, typename T_Height>
+	inline void DurableAVLTree<T, T_Height>::Append(char op, const T& data)
+	{
+		char record[record_bytes];
+		record[0] = op;
+		std::memcpy(record + 1, &data, sizeof(T));
+		std::uint32_t checksum = Checksum(record, 1 + sizeof(T));
+		std::memcpy(record + 1 + sizeof(T), &checksum, sizeof(checksum));
+
+		if (buffered == 0)
+			oldest = clock::now();
+		buffer.insert(buffer.end(), record, record + record_bytes);
+		++buffered;
+		++since_checkpoint;
+
+		if (buffered >= options.batch
+			|| (options.sync_interval.count() != 0 && clock::now() - oldest >= options.sync_interval))
+			Commit();
+
+		if (options.checkpoint_every != 0 && since_checkpoint >= options.checkpoint_every)
+			checkpoint();
+	}
+
+	// Write + fsync The Buffered Records (one group commit)
+	template<typename T, typename T_Height>
+	inline void DurableAVLTree<T, T_Height>::Commit()
+	{
+		if (buffered == 0)
+			return;
+
+		if (log == nullptr || std::fwrite(buffer.data(), 1, buffer.size(), log.get()) != buffer.size())
+			throw std::runtime_error("DurableAVLTree: log write failed");
+		SyncFile(log.get());
+
+		buffer.clear();
+		buffered = 0;
+	}
+
+	// _Private Methods
+
+	//
+	// Public Constructors
+	//
+
+	template<typename T, typename T_Height>
+	inline DurableAVLTree<T, T_Height>::DurableAVLTree(const std::string& directory, DurableOptions options)
+		: directory(directory), options(options)
+	{
+		if (this->options.batch == 0)
+			this->options.batch = 1;
+
+		Recover();
+
+		// replayed records move into a fresh snapshot, so the log never grows across restarts
+		if (recovery.log_records != 0 || recovery.dropped_bytes != 0)
+			checkpoint();
+		else
+			OpenLog();
+	}
+
+	template<typename T, typename T_Height>
+	inline DurableAVLTree<T, T_Height>::~DurableAVLTree()
+	{
+		try
+		{
+			Commit();
+		}
+		catch (...)
+		{
+		}
+	}
+
+	// _Public Constructors
+
+	//
+	// Public Methods
+	//
+
+	template<typename T, typename T_Height>
+	inline bool DurableAVLTree<T, T_Height>::insert(const T& data)
+	{
+		if (!Base::insert(data))
+			return false;
+
+		Append('I', data);
+		return true;
+	}
+
+	template<typename T, typename T_Height>
+	inline bool DurableAVLTree<T, T_Height>::erase(const T& data)
+	{
+		if (!Base::erase(data))
+			return false;
+
+		Append('E', data);
+		return true;
+	}
+
+	template<typename T, typename T_Height>
+	inline void DurableAVLTree<T, T_Height>::sync()
+	{
+		Commit();
+	}
+
+	template<typename T, typename T_Height>
+	inline void DurableAVLTree<T, T_Height>::checkpoint()
+	{
+		std::vector<T> keys;
+		keys.reserve(Base::size());
+		for (auto it = Base::cursor_begin(); it != Base::cursor_end(); ++it)
+			keys.push_back(*it);
+
+		File snapshot(std::fopen(path("snapshot.tmp").c_str(), "wb"));
+		if (snapshot == nullptr)
+			throw std::runtime_error("DurableAVLTree: cannot create snapshot in " + directory);
+
+		std::uint32_t magic = snapshot_magic;
+		std::uint64_t next = generation + 1, count = keys.size();
+		std::uint32_t header_checksum = HeaderChecksum(next, count);
+		std::uint32_t checksum = Checksum(reinterpret_cast<const char*>(keys.data()), keys.size() * sizeof(T));
+		std::fwrite(&magic, sizeof(magic), 1, snapshot.get());
+		std::fwrite(&next, sizeof(next), 1, snapshot.get());
+		std::fwrite(&count, sizeof(count), 1, snapshot.get());
+		std::fwrite(&header_checksum, sizeof(header_checksum), 1, snapshot.get());
+		std::fwrite(keys.data(), sizeof(T), keys.size(), snapshot.get());
+		std::fwrite(&checksum, sizeof(checksum), 1, snapshot.get());
+		SyncFile(snapshot.get());
+		snapshot.reset();
+
+		// from here on the old log (generation) is ignored at recovery
+		if (std::rename(path("snapshot.tmp").c_str(), path("snapshot").c_str()) != 0)
+			throw std::runtime_error("DurableAVLTree: cannot rename snapshot in " + directory);
+		SyncDirectory();
+
+		// records still buffered are part of the tree and the snapshot now covers them; until the
+		// rename they stay buffered, so a failed checkpoint loses nothing
+		buffer.clear();
+		buffered = 0;
+		since_checkpoint = 0;
+
+		generation = next;
+		OpenLog();
+	}
+
+	template<typename T, typename T_Height>
+	inline std::size_t DurableAVLTree<T, T_Height>::pending() const
+	{
+		return buffered;
+	}
+
+	template<typename T, typename T_Height>
+	inline const RecoveryStats& DurableAVLTree<T, T_Height>::recovered() const
+	{
+		return recovery;
+	}
+
+	// _Public Methods
+}
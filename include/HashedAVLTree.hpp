@@ -0,0 +1,174 @@
+#pragma once
+#include "AVLTree.hpp"
+#include <cstdint>
+#include <functional>
+
+namespace Tree
+{
+	// Node Augmentation: sum of mixed element hashes of the subtree (does not depend on the shape)
+	template<typename T, typename Hash = std::hash<T>>
+	struct HashAugment : NoAugment
+	{
+		std::uint64_t own = 0;  // mixed hash of data, 0 = not computed yet
+		std::uint64_t hash = 0; // own + children
+
+		// splitmix64 finalizer, so that sums of hashes do not collide for small integers
+		static std::uint64_t Mix(std::uint64_t value)
+		{
+			value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ULL;
+			value = (value ^ (value >> 27)) * 0x94d049bb133111ebULL;
+			return (value ^ (value >> 31)) | 1;
+		}
+
+		template<typename Node>
+		static void update(Node* root)
+		{
+			if (root->own == 0)
+				root->own = Mix(Hash()(root->data));
+
+			root->hash = root->own + (root->left ? root->left->hash : 0) + (root->right ? root->right->hash : 0);
+		}
+
+		template<typename Node>
+		static unsigned int count(const Node* root)
+		{
+			return root ? root->size_l + root->size_r + 1u : 0u;
+		}
+
+		// Hash + Count Of Elements Less Than bound (or_equal: <= bound)
+		template<typename Node>
+		static void Prefix(const Node* root, const T& bound, bool or_equal, std::uint64_t& hash, unsigned int& elements)
+		{
+			while (root)
+			{
+				if (root->data < bound || (or_equal && root->data == bound))
+				{
+					hash += root->own + (root->left ? root->left->hash : 0);
+					elements += root->size_l + 1;
+					root = root->right;
+				}
+				else
+					root = root->left;
+			}
+		}
+
+		// Hash + Count Of Elements Strictly Between lo And hi (nullptr = unbounded)
+		template<typename Node>
+		static void Range(const Node* root, const T* lo, const T* hi, std::uint64_t& hash, unsigned int& elements)
+		{
+			std::uint64_t hash_hi = root ? root->hash : 0, hash_lo = 0;
+			unsigned int count_hi = count(root), count_lo = 0;
+
+			if (hi)
+			{
+				hash_hi = 0;
+				count_hi = 0;
+				Prefix(root, *hi, false, hash_hi, count_hi);
+			}
+			if (lo)
+				Prefix(root, *lo, true, hash_lo, count_lo);
+
+			hash = hash_hi - hash_lo;
+			elements = count_hi - count_lo;
+		}
+
+		// Visit Elements Strictly Between lo And hi
+		template<typename Node, typename Visitor>
+		static void Enumerate(const Node* root, const T* lo, const T* hi, Visitor& visit)
+		{
+			while (root)
+			{
+				if (lo && !(*lo < root->data))
+					root = root->right;
+				else if (hi && !(root->data < *hi))
+					root = root->left;
+				else
+				{
+					Enumerate(root->left, lo, nullptr, visit);
+					visit(root->data, false);
+					lo = &root->data;
+					root = root->right;
+				}
+			}
+		}
+
+		template<typename Node>
+		static bool Contains(const Node* root, const T& data)
+		{
+			while (root && root->data != data)
+				root = (data < root->data ? root->left : root->right);
+
+			return root != nullptr;
+		}
+
+		// R || Report Elements Of mine (one subtree, strictly between lo and hi) Or Of others That Differ
+		template<typename Node, typename Visitor>
+		static void Diff(const Node* mine, const T* lo, const T* hi, const Node* others, Visitor& visit)
+		{
+			std::uint64_t hash;
+			unsigned int elements;
+			Range(others, lo, hi, hash, elements);
+
+			if (hash == (mine ? mine->hash : 0) && elements == count(mine))
+				return;
+
+			if (mine == nullptr)
+			{
+				Enumerate(others, lo, hi, visit);
+				return;
+			}
+
+			Diff(mine->left, lo, &mine->data, others, visit);
+			if (!Contains(others, mine->data))
+				visit(mine->data, true);
+			Diff(mine->right, &mine->data, hi, others, visit);
+		}
+	};
+
+	// AVLTree With Subtree Hashes: equal() and diff() skip subtrees whose contents match
+	template<typename T, typename T_Height = unsigned char, typename Hash = std::hash<T>>
+	class HashedAVLTree : public AVLTree<T, T_Height, HashAugment<T, Hash>>
+	{
+	private:
+		using Base = AVLTree<T, T_Height, HashAugment<T, Hash>>;
+
+	public: // Constructors
+		using Base::Base;
+
+	public: // Methods
+		// Hash Of The Whole Contents (equal contents => equal hash, whatever the shapes)
+		std::uint64_t content_hash() const;
+
+		// Equal Contents, Decided By Hashes (collision chance ~2^-64; operator== is exact)
+		bool equal(const HashedAVLTree& other) const;
+
+		// Visit Elements In Only One Tree: visit(data, true) only in *this, visit(data, false) only in other
+		template<typename Visitor>
+		void diff(const HashedAVLTree& other, Visitor visit) const;
+	};
+
+	//
+	// Public Methods
+	//
+
+	template<typename T, typename T_Height, typename Hash>
+	inline std::uint64_t HashedAVLTree<T, T_Height, Hash>::content_hash() const
+	{
+		return this->root ? this->root->hash : 0;
+	}
+
+	template<typename T, typename T_Height, typename Hash>
+	inline bool HashedAVLTree<T, T_Height, Hash>::equal(const HashedAVLTree& other) const
+	{
+		return this->size() == other.size() && content_hash() == other.content_hash();
+	}
+
+	template<typename T, typename T_Height, typename Hash>
+	template<typename Visitor>
+	inline void HashedAVLTree<T, T_Height, Hash>::diff(const HashedAVLTree& other, Visitor visit) const
+	{
+		HashAugment<T, Hash>::Diff(this->root, static_cast<const T*>(nullptr), static_cast<const T*>(nullptr), other.root, visit);
+	}
+
+	// _Public Methods
+}
@@ -0,0 +1,264 @@
+#pragma once
+#include "AVLTree.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <new>
+#include <vector>
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+namespace Tree
+{
+	// Fixed-Size Blocks In 2MB Slabs: huge pages when the system has them, one free list per slab
+	class HugePageArena
+	{
+	public:
+		static constexpr std::size_t slab_bytes = std::size_t(2) << 20;
+
+		struct Stats
+		{
+			std::size_t slabs = 0;         // 2MB slabs mapped
+			std::size_t huge_slabs = 0;    // backed by a reserved huge page (MAP_HUGETLB)
+			std::size_t advised_slabs = 0; // normal pages + madvise(MADV_HUGEPAGE)
+			std::size_t blocks = 0;        // blocks in use
+		};
+
+	private:
+		// Slab Header, At The Start Of Every 2MB-Aligned Slab
+		struct Slab
+		{
+			Slab* next;
+			void* free;       // freed blocks, linked through their first word
+			std::size_t bump; // offset of the first never-used block
+		};
+
+		static constexpr std::size_t first_block = (sizeof(Slab) + alignof(std::max_align_t) - 1) / alignof(std::max_align_t) * alignof(std::max_align_t);
+
+		Slab* slabs = nullptr;
+		Slab* current = nullptr; // slab new blocks come from when there is no usable hint
+		std::vector<const Slab*> mapped; // every slab of this arena, sorted: a hint is trusted only inside one
+		Stats stats_;
+		std::atomic_flag busy = ATOMIC_FLAG_INIT;
+
+		// Map One 2MB-Aligned Slab (huge page, else normal pages asked to become one)
+		void* MapSlab();
+
+		static Slab* SlabOf(const void* block)
+		{
+			return reinterpret_cast<Slab*>(reinterpret_cast<std::uintptr_t>(block) & ~(slab_bytes - 1));
+		}
+
+		// near Lies In A Slab This Arena Mapped (a hint may point into operator new memory, e.g. a compact() block)
+		bool Owns(const void* near) const
+		{
+			auto slab = std::lower_bound(mapped.begin(), mapped.end(), SlabOf(near), std::less<const Slab*>());
+			return slab != mapped.end() && *slab == SlabOf(near);
+		}
+
+		static void* Take(Slab* slab, std::size_t block)
+		{
+			if (slab->free != nullptr)
+			{
+				void* result = slab->free;
+				slab->free = *static_cast<void**>(result);
+				return result;
+			}
+			if (slab->bump + block <= slab_bytes)
+			{
+				void* result = reinterpret_cast<char*>(slab) + slab->bump;
+				slab->bump += block;
+				return result;
+			}
+			return nullptr;
+		}
+
+	public:
+		HugePageArena() = default;
+		HugePageArena(const HugePageArena&) = delete;
+		HugePageArena& operator=(const HugePageArena&) = delete;
+
+		// Block Of block Bytes, From near's Slab When It Has Room (keeps a subtree on one page)
+		void* allocate(std::size_t block, const void* near);
+		void deallocate(void* pointer);
+
+		Stats stats();
+	};
+
+	// Node Storage Option: Tree::AVLTree<T, T_Height, Tree::HugePageStorage<>> (or HugePageStorage<SomeAugment>)
+	// every node comes from a HugePageArena shared by all trees with the same node size; a child is placed
+	// on its parent's slab while that slab has room. Freed nodes go back to their slab, not to the system
+	template<typename Base = NoAugment>
+	struct HugePageStorage : Base
+	{
+		static constexpr std::size_t max_node = 1024; // bigger nodes use the global operator new
+
+		// Called Before insert() Allocates A Child Of parent
+		template<typename Node>
+		static void place(const Node* parent)
+		{
+			Hint() = parent;
+		}
+
+		static void* operator new(std::size_t size)
+		{
+			const void* near = Hint();
+			Hint() = nullptr;
+			if (size > max_node)
+				return ::operator new(size);
+
+			return ArenaFor(size).allocate(Rounded(size), near);
+		}
+
+		static void operator delete(void* pointer, std::size_t size)
+		{
+			if (size > max_node)
+				::operator delete(pointer);
+			else if (pointer != nullptr)
+				ArenaFor(size).deallocate(pointer);
+		}
+
+		// Totals Over Every Arena (all node sizes)
+		static HugePageArena::Stats stats()
+		{
+			HugePageArena::Stats total;
+			for (std::size_t i = 0; i < max_node / alignof(std::max_align_t); ++i)
+			{
+				HugePageArena::Stats one = Arenas()[i].stats();
+				total.slabs += one.slabs;
+				total.huge_slabs += one.huge_slabs;
+				total.advised_slabs += one.advised_slabs;
+				total.blocks += one.blocks;
+			}
+			return total;
+		}
+
+	private:
+		static std::size_t Rounded(std::size_t size)
+		{
+			return (size + alignof(std::max_align_t) - 1) / alignof(std::max_align_t) * alignof(std::max_align_t);
+		}
+
+		static HugePageArena* Arenas()
+		{
+			static HugePageArena arenas[max_node / alignof(std::max_align_t)];
+			return arenas;
+		}
+
+		static HugePageArena& ArenaFor(std::size_t size)
+		{
+			return Arenas()[Rounded(size) / alignof(std::max_align_t) - 1];
+		}
+
+		static const void*& Hint()
+		{
+			static thread_local const void* hint = nullptr;
+			return hint;
+		}
+	};
+
+	//
+	// HugePageArena
+	//
+
+	// Map One 2MB-Aligned Slab (huge page, else normal pages asked to become one)
+	inline void* HugePageArena::MapSlab()
+	{
+#if defined(__linux__)
+#if defined(MAP_HUGETLB)
+		void* huge = mmap(nullptr, slab_bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+		if (huge != MAP_FAILED)
+		{
+			++stats_.huge_slabs;
+			return huge;
+		}
+#endif
+		// no reserved huge pages: map twice the size and keep the 2MB-aligned part
+		void* raw = mmap(nullptr, 2 * slab_bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+		if (raw == MAP_FAILED)
+			throw std::bad_alloc();
+
+		std::uintptr_t begin = reinterpret_cast<std::uintptr_t>(raw);
+		std::uintptr_t aligned = (begin + slab_bytes - 1) & ~(slab_bytes - 1);
+		if (aligned != begin)
+			munmap(raw, aligned - begin);
+		munmap(reinterpret_cast<void*>(aligned + slab_bytes), begin + slab_bytes - aligned);
+
+#if defined(MADV_HUGEPAGE)
+		if (madvise(reinterpret_cast<void*>(aligned), slab_bytes, MADV_HUGEPAGE) == 0)
+			++stats_.advised_slabs;
+#endif
+		return reinterpret_cast<void*>(aligned);
+#else
+		// no mmap: aligned slab inside a bigger allocation (slabs live until exit)
+		std::uintptr_t begin = reinterpret_cast<std::uintptr_t>(::operator new(2 * slab_bytes));
+		return reinterpret_cast<void*>((begin + slab_bytes - 1) & ~(slab_bytes - 1));
+#endif
+	}
+
+	inline void* HugePageArena::allocate(std::size_t block, const void* near)
+	{
+		while (busy.test_and_set(std::memory_order_acquire)) { }
+
+		void* result = nullptr;
+		if (near != nullptr && Owns(near))
+			result = Take(SlabOf(near), block);
+		if (result == nullptr && current != nullptr)
+			result = Take(current, block);
+
+		if (result == nullptr)
+		{
+			void* memory = nullptr;
+			try
+			{
+				mapped.reserve(mapped.size() + 1);
+				memory = MapSlab();
+			}
+			catch (...)
+			{
+				busy.clear(std::memory_order_release);
+				throw;
+			}
+
+			Slab* slab = static_cast<Slab*>(memory);
+			slab->next = slabs;
+			slab->free = nullptr;
+			slab->bump = first_block;
+			slabs = current = slab;
+			mapped.insert(std::upper_bound(mapped.begin(), mapped.end(), slab, std::less<const Slab*>()), slab);
+			++stats_.slabs;
+			result = Take(slab, block);
+		}
+
+		++stats_.blocks;
+		busy.clear(std::memory_order_release);
+		return result;
+	}
+
+	inline void HugePageArena::deallocate(void* pointer)
+	{
+		while (busy.test_and_set(std::memory_order_acquire)) { }
+
+		Slab* slab = SlabOf(pointer);
+		*static_cast<void**>(pointer) = slab->free;
+		slab->free = pointer;
+		--stats_.blocks;
+
+		// a slab with a hole is reused before the bump end of a newer one
+		current = slab;
+		busy.clear(std::memory_order_release);
+	}
+
+	inline HugePageArena::Stats HugePageArena::stats()
+	{
+		while (busy.test_and_set(std::memory_order_acquire)) { }
+		Stats result = stats_;
+		busy.clear(std::memory_order_release);
+		return result;
+	}
+
+	// _HugePageArena
+}
@@ -0,0 +1,104 @@
+#pragma once
+#include "AVLTree.hpp"
+#include <utility>
+
+namespace Tree
+{
+	// Node Augmentation: maximal right endpoint of the subtree
+	template<typename P>
+	struct IntervalAugment : NoAugment
+	{
+		P max_end = P();
+
+		// Update Max Endpoint (called from AVLTree::update, so every rotation keeps it)
+		template<typename Node>
+		static void update(Node* root)
+		{
+			root->max_end = root->data.second;
+			if (root->left && root->max_end < root->left->max_end)
+				root->max_end = root->left->max_end;
+			if (root->right && root->max_end < root->right->max_end)
+				root->max_end = root->right->max_end;
+		}
+
+		// Visit Every Interval [first, second] That Intersects [lo, hi]
+		template<typename Node, typename Visitor>
+		static void overlapping(const Node* root, const P& lo, const P& hi, Visitor& visit)
+		{
+			while (root && !(root->max_end < lo))
+			{
+				overlapping(root->left, lo, hi, visit);
+
+				if (hi < root->data.first) // every right element starts even later
+					return;
+
+				if (!(root->data.second < lo))
+					visit(root->data);
+
+				root = root->right;
+			}
+		}
+	};
+
+	template<typename P, typename T_Height = unsigned char>
+	class IntervalTree : public AVLTree<std::pair<P, P>, T_Height, IntervalAugment<P>>
+	{
+	private:
+		using Base = AVLTree<std::pair<P, P>, T_Height, IntervalAugment<P>>;
+
+	public: // Constructors
+		using interval_type = std::pair<P, P>;
+		using Base::Base;
+
+	public: // Methods
+		// Visit Intervals That Contain point
+		template<typename Visitor>
+		void overlapping(const P& point, Visitor visit) const;
+
+		// Visit Intervals That Intersect interval
+		template<typename Visitor>
+		void overlapping(const interval_type& interval, Visitor visit) const;
+
+		// Count Intervals That Contain point
+		unsigned int count_overlapping(const P& point) const;
+
+		// Count Intervals That Intersect interval
+		unsigned int count_overlapping(const interval_type& interval) const;
+	};
+
+	//
+	// Public Methods
+	//
+
+	template<typename P, typename T_Height>
+	template<typename Visitor>
+	inline void IntervalTree<P, T_Height>::overlapping(const P& point, Visitor visit) const
+	{
+		IntervalAugment<P>::overlapping(this->root, point, point, visit);
+	}
+
+	template<typename P, typename T_Height>
+	template<typename Visitor>
+	inline void IntervalTree<P, T_Height>::overlapping(const interval_type& interval, Visitor visit) const
+	{
+		IntervalAugment<P>::overlapping(this->root, interval.first, interval.second, visit);
+	}
+
+	template<typename P, typename T_Height>
+	inline unsigned int IntervalTree<P, T_Height>::count_overlapping(const P& point) const
+	{
+		unsigned int count = 0;
+		overlapping(point, [&count](const interval_type&) { ++count; });
+		return count;
+	}
+
+	template<typename P, typename T_Height>
+	inline unsigned int IntervalTree<P, T_Height>::count_overlapping(const interval_type& interval) const
+	{
+		unsigned int count = 0;
+		overlapping(interval, [&count](const interval_type&) { ++count; });
+		return count;
+	}
+
+	// _Public Methods
+}
@@ -0,0 +1,278 @@
+#pragma once
+#include "AVLTree.hpp"
+#include <type_traits>
+
+namespace Tree
+{
+	template<typename T, typename T_Height>
+	class IntrusiveAVLTree;
+
+	// Embedded Node: struct Element : Tree::AVLHook<Element> { ... };
+	template<typename Derived, typename T_Height = unsigned char>
+	class AVLHook
+	{
+	private:
+		Derived* left = nullptr;
+		Derived* right = nullptr;
+		T_Height height = 1;
+		unsigned short size_r = 0, size_l = 0;
+
+		template<typename, typename, typename> friend class AVLBalance;
+		template<typename, typename> friend class IntrusiveAVLTree;
+
+	public:
+		AVLHook() = default;
+
+		// a copy of an element is never linked, the original keeps its place
+		AVLHook(const AVLHook&) { }
+		AVLHook& operator=(const AVLHook&) { return *this; }
+	};
+
+	// AVL Tree Over User-Owned Elements (T derives from AVLHook<T, T_Height>): no allocation, no copies
+	template<typename T, typename T_Height = unsigned char>
+	class IntrusiveAVLTree
+	{
+		static_assert(std::is_base_of<AVLHook<T, T_Height>, T>::value, "T must derive from Tree::AVLHook<T, T_Height> (same T_Height as the tree)");
+
+	private:
+		using Balance = AVLBalance<T, T_Height>;
+
+		T* root = nullptr;
+		T* erased = nullptr;
+		mutable bool isSuccessfully = true;
+		unsigned short size_ = 0;
+
+		// R || Link Element + Balance
+		T* insert_(T* root, T& element);
+
+		// R || Unlink Element + Balance
+		T* erase_(T* root, const T& data);
+
+		// R || In-Order Walk
+		template<typename Visitor>
+		static void for_each_(T* root, Visitor& visit);
+
+	public: // Constructors
+		IntrusiveAVLTree() = default;
+
+		// elements belong to one tree at a time
+		IntrusiveAVLTree(const IntrusiveAVLTree<T, T_Height>&) = delete;
+		IntrusiveAVLTree<T, T_Height>& operator=(const IntrusiveAVLTree<T, T_Height>&) = delete;
+
+		IntrusiveAVLTree(IntrusiveAVLTree<T, T_Height>&& other) noexcept;
+		IntrusiveAVLTree<T, T_Height>& operator=(IntrusiveAVLTree<T, T_Height>&& other) noexcept;
+
+	public: // Methods
+		// Link element (false if an equal element is already linked)
+		bool insert(T& element);
+
+		// Unlink The Element Equal To data + Return It (nullptr if none)
+		T* erase(const T& data);
+
+		T* find(const T& data) const;
+
+		// Number Of Elements Less Than data
+		unsigned int rank(const T& data) const;
+
+		// Forget Every Element (the elements themselves are untouched)
+		void clear();
+
+		unsigned short size() const;
+
+		// Visit Elements In Order
+		template<typename Visitor>
+		void for_each(Visitor visit) const;
+	};
+
+	//
+	// Private Methods
+	//
+
+	// R || Link Element + Balance
+	template<typename T, typename T_Height>
+	inline T* IntrusiveAVLTree<T, T_Height>::insert_(T* root, T& element)
+	{
+		if (root == nullptr)
+		{
+			element.left = element.right = nullptr;
+			element.height = 1;
+			element.size_l = element.size_r = 0;
+			return &element;
+		}
+		else if (element < *root)
+		{
+			root->left = insert_(root->left, element);
+		}
+		else if (element > *root)
+		{
+			root->right = insert_(root->right, element);
+		}
+		else
+		{
+			isSuccessfully = false;
+			return root;
+		}
+
+		return isSuccessfully ? Balance::balance(root) : root;
+	}
+
+	// R || Unlink Element + Balance
+	template<typename T, typename T_Height>
+	inline T* IntrusiveAVLTree<T, T_Height>::erase_(T* root, const T& data)
+	{
+		if (root == nullptr)
+		{
+			isSuccessfully = false;
+			return nullptr;
+		}
+		else if (*root == data)
+		{
+			erased = root;
+			if (root->right != nullptr)
+			{
+				T* minroot = Balance::GetMinElement(root->right);
+				if (minroot == root->right)
+				{
+					root = root->right;
+				}
+				else
+				{
+					root = minroot;
+					root->right = Balance::RemBalMin(erased->right, minroot);
+				}
+				root->left = erased->left;
+			}
+			else
+			{
+				root = root->left;
+			}
+		}
+		else if (data < *root)
+		{
+			root->left = erase_(root->left, data);
+		}
+		else if (data > *root)
+		{
+			root->right = erase_(root->right, data);
+		}
+
+		return isSuccessfully ? Balance::balance(root) : root;
+	}
+
+	// R || In-Order Walk
+	template<typename T, typename T_Height>
+	template<typename Visitor>
+	inline void IntrusiveAVLTree<T, T_Height>::for_each_(T* root, Visitor& visit)
+	{
+		while (root)
+		{
+			for_each_(root->left, visit);
+			visit(*root);
+			root = root->right;
+		}
+	}
+
+	// _Private Methods
+
+	//
+	// Public Constructors
+	//
+
+	template<typename T, typename T_Height>
+	inline IntrusiveAVLTree<T, T_Height>::IntrusiveAVLTree(IntrusiveAVLTree<T, T_Height>&& other) noexcept
+		: root(other.root), size_(other.size_)
+	{
+		other.root = nullptr;
+		other.size_ = 0;
+	}
+
+	template<typename T, typename T_Height>
+	inline IntrusiveAVLTree<T, T_Height>& IntrusiveAVLTree<T, T_Height>::operator=(IntrusiveAVLTree<T, T_Height>&& other) noexcept
+	{
+		if (this != &other)
+		{
+			root = other.root;
+			size_ = other.size_;
+			other.root = nullptr;
+			other.size_ = 0;
+		}
+
+		return *this;
+	}
+
+	// _Public Constructors
+
+	//
+	// Public Methods
+	//
+
+	template<typename T, typename T_Height>
+	inline bool IntrusiveAVLTree<T, T_Height>::insert(T& element)
+	{
+		isSuccessfully = true;
+		root = insert_(root, element);
+		size_ += isSuccessfully;
+		return isSuccessfully;
+	}
+
+	template<typename T, typename T_Height>
+	inline T* IntrusiveAVLTree<T, T_Height>::erase(const T& data)
+	{
+		isSuccessfully = true;
+		erased = nullptr;
+		root = erase_(root, data);
+		size_ -= isSuccessfully;
+		return erased;
+	}
+
+	template<typename T, typename T_Height>
+	inline T* IntrusiveAVLTree<T, T_Height>::find(const T& data) const
+	{
+		T* current = root;
+		while (current && *current != data)
+			current = (data < *current ? current->left : current->right);
+
+		return current;
+	}
+
+	template<typename T, typename T_Height>
+	inline unsigned int IntrusiveAVLTree<T, T_Height>::rank(const T& data) const
+	{
+		unsigned int less = 0;
+		T* current = root;
+		while (current)
+		{
+			if (*current < data)
+			{
+				less += current->size_l + 1;
+				current = current->right;
+			}
+			else
+				current = current->left;
+		}
+
+		return less;
+	}
+
+	template<typename T, typename T_Height>
+	inline void IntrusiveAVLTree<T, T_Height>::clear()
+	{
+		root = nullptr;
+		size_ = 0;
+	}
+
+	template<typename T, typename T_Height>
+	inline unsigned short IntrusiveAVLTree<T, T_Height>::size() const
+	{
+		return size_;
+	}
+
+	template<typename T, typename T_Height>
+	template<typename Visitor>
+	inline void IntrusiveAVLTree<T, T_Height>::for_each(Visitor visit) const
+	{
+		for_each_(root, visit);
+	}
+
+	// _Public Methods
+}
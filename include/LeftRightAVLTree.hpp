@@ -0,0 +1,189 @@
+#pragma once
+#include "AVLTree.hpp"
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Tree
+{
+	// Read-Mostly AVLTree (left-right): two copies, readers never lock and never write a shared cache line,
+	// a writer changes the copy nobody reads, publishes it, waits for the readers of the other one and repeats
+	template<typename T, typename T_Height = unsigned char>
+	class LeftRightAVLTree
+	{
+	public:
+		using tree_type = AVLTree<T, T_Height>;
+
+		//
+		// Reader: per-thread read indicator, only its owner writes it (keep one per reader thread)
+		//
+		class Reader
+		{
+		private:
+			char front[64]; // the two counters get a cache line of their own
+			std::atomic<unsigned int> reading[2];
+			char back[64];
+
+			friend class LeftRightAVLTree;
+
+		public:
+			Reader() { reading[0] = 0; reading[1] = 0; }
+			Reader(const Reader&) = delete;
+			Reader& operator=(const Reader&) = delete;
+		};
+
+	private:
+		tree_type trees[2];
+		std::atomic<unsigned int> active{ 0 };  // index of the tree readers use
+		std::atomic<unsigned int> version{ 0 }; // index of the read indicator readers arrive at
+		std::vector<std::unique_ptr<Reader>> readers;
+		mutable std::mutex writer;
+
+		// Wait Until No Reader Is Counted In Indicator index
+		void WaitEmpty(unsigned int index) const;
+
+	public: // Constructors
+		LeftRightAVLTree() = default;
+		explicit LeftRightAVLTree(const tree_type& initial);
+
+		// readers hold references into the tree
+		LeftRightAVLTree(const LeftRightAVLTree&) = delete;
+		LeftRightAVLTree& operator=(const LeftRightAVLTree&) = delete;
+
+	public: // Methods
+		// Register A Reader (writer lock, do it once per thread); lives as long as the tree
+		Reader& reader();
+
+		// Wait-Free Read: f(const tree_type&) on the published copy, the copy does not change while f runs
+		template<typename F>
+		auto read(Reader& reader, F f) const -> decltype(f(std::declval<const tree_type&>()));
+
+		bool contains(Reader& reader, const T& data) const;
+
+		// Apply f(tree_type&) To Both Copies In Turn (f must give the same result on equal trees)
+		template<typename F>
+		auto write(F f) -> decltype(f(std::declval<tree_type&>()));
+
+		bool insert(const T& data);
+		bool erase(const T& data);
+
+		// Replace The Contents (copy assignment reuses the nodes of both copies)
+		void assign(const tree_type& contents);
+
+		// Size Under The Writer Lock (readers: read(reader, ...).size())
+		unsigned short size() const;
+	};
+
+	//
+	// Private Methods
+	//
+
+	// Wait Until No Reader Is Counted In Indicator index
+	template<typename T, typename T_Height>
+	inline void LeftRightAVLTree<T, T_Height>::WaitEmpty(unsigned int index) const
+	{
+		for (const std::unique_ptr<Reader>& reader : readers)
+		{
+			while (reader->reading[index].load(std::memory_order_seq_cst) != 0)
+				std::this_thread::yield();
+		}
+	}
+
+	// _Private Methods
+
+	//
+	// Public Constructors
+	//
+
+	template<typename T, typename T_Height>
+	inline LeftRightAVLTree<T, T_Height>::LeftRightAVLTree(const tree_type& initial)
+		: trees{ initial, initial }
+	{
+	}
+
+	// _Public Constructors
+
+	//
+	// Public Methods
+	//
+
+	template<typename T, typename T_Height>
+	inline typename LeftRightAVLTree<T, T_Height>::Reader& LeftRightAVLTree<T, T_Height>::reader()
+	{
+		std::lock_guard<std::mutex> lock(writer);
+		readers.emplace_back(new Reader());
+		return *readers.back();
+	}
+
+	template<typename T, typename T_Height>
+	template<typename F>
+	inline auto LeftRightAVLTree<T, T_Height>::read(Reader& reader, F f) const -> decltype(f(std::declval<const tree_type&>()))
+	{
+		// arrive: a plain store to the reader's own line (only this thread writes it)
+		const unsigned int index = version.load(std::memory_order_seq_cst);
+		std::atomic<unsigned int>& reading = reader.reading[index];
+		reading.store(reading.load(std::memory_order_relaxed) + 1, std::memory_order_seq_cst);
+
+		struct Depart
+		{
+			std::atomic<unsigned int>& reading;
+			~Depart() { reading.store(reading.load(std::memory_order_relaxed) - 1, std::memory_order_release); }
+		} depart{ reading };
+
+		return f(trees[active.load(std::memory_order_seq_cst)]);
+	}
+
+	template<typename T, typename T_Height>
+	inline bool LeftRightAVLTree<T, T_Height>::contains(Reader& reader, const T& data) const
+	{
+		return read(reader, [&](const tree_type& tree) { return tree.find(data) != nullptr; });
+	}
+
+	template<typename T, typename T_Height>
+	template<typename F>
+	inline auto LeftRightAVLTree<T, T_Height>::write(F f) -> decltype(f(std::declval<tree_type&>()))
+	{
+		std::lock_guard<std::mutex> lock(writer);
+		const unsigned int published = active.load(std::memory_order_relaxed);
+
+		f(trees[published ^ 1]);
+		active.store(published ^ 1, std::memory_order_seq_cst);
+
+		// readers that may still see the old copy arrived at one of the two indicators: drain both
+		const unsigned int previous = version.load(std::memory_order_relaxed);
+		WaitEmpty(previous ^ 1);
+		version.store(previous ^ 1, std::memory_order_seq_cst);
+		WaitEmpty(previous);
+
+		return f(trees[published]);
+	}
+
+	template<typename T, typename T_Height>
+	inline bool LeftRightAVLTree<T, T_Height>::insert(const T& data)
+	{
+		return write([&](tree_type& tree) { return tree.insert(data); });
+	}
+
+	template<typename T, typename T_Height>
+	inline bool LeftRightAVLTree<T, T_Height>::erase(const T& data)
+	{
+		return write([&](tree_type& tree) { return tree.erase(data); });
+	}
+
+	template<typename T, typename T_Height>
+	inline void LeftRightAVLTree<T, T_Height>::assign(const tree_type& contents)
+	{
+		write([&](tree_type& tree) { tree = contents; });
+	}
+
+	template<typename T, typename T_Height>
+	inline unsigned short LeftRightAVLTree<T, T_Height>::size() const
+	{
+		std::lock_guard<std::mutex> lock(writer);
+		return trees[active.load(std::memory_order_relaxed)].size();
+	}
+
+	// _Public Methods
+}
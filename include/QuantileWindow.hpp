@@ -0,0 +1,173 @@
+#pragma once
+#include "AVLTree.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace Tree
+{
+	// Sliding Window Of The Last capacity Samples (at most 65535, the size of one AVLTree) With
+	// Order Statistics: push / expire in O(log n), any quantile in O(log n) by subtree-count selection,
+	// top-k / bottom-k in O(log n + k). Equal samples are kept apart by their sequence number (multiset)
+	template<typename T, typename T_Height = unsigned char>
+	class QuantileWindow
+	{
+	public:
+		using key_type = std::pair<T, std::uint64_t>; // (sample, sequence number)
+		using tree_type = AVLTree<key_type, T_Height>;
+
+	private:
+		tree_type tree;
+		std::vector<T> ring;      // sample of sequence s at ring[s % capacity]
+		std::uint64_t first = 0;  // sequence of the oldest sample in the window
+		std::uint64_t next = 0;   // sequence of the next push
+
+		// Copy Ranks [lo, lo + k) Into out, Ascending (no shared buffer: concurrent readers are safe)
+		void Export(std::size_t lo, std::size_t k, std::vector<T>& out) const;
+
+	public: // Constructors
+		explicit QuantileWindow(std::size_t capacity);
+
+	public: // Methods
+		// Add A Sample, Expiring The Oldest One When The Window Is Full
+		void push(const T& sample);
+
+		// Drop The count Oldest Samples (time-based windows: expire what fell out, then push)
+		void expire(std::size_t count = 1);
+
+		std::size_t size() const;
+		std::size_t capacity() const;
+		bool empty() const;
+
+		// Sample Of Rank floor(q * (size() - 1)), q In [0, 1] (throws std::out_of_range on an empty window)
+		const T& quantile(double q) const;
+
+		// Sample With index Smaller Samples (throws std::out_of_range if index >= size())
+		const T& select(std::size_t index) const;
+
+		// The k Largest Samples, Largest First / The k Smallest, Smallest First (fewer if size() < k)
+		void top_k(std::size_t k, std::vector<T>& out) const;
+		void bottom_k(std::size_t k, std::vector<T>& out) const;
+
+		void clear();
+	};
+
+	//
+	// Private Methods
+	//
+
+	template<typename T, typename T_Height>
+	inline void QuantileWindow<T, T_Height>::Export(std::size_t lo, std::size_t k, std::vector<T>& out) const
+	{
+		out.clear();
+		if (k == 0)
+			return;
+
+		out.reserve(k);
+		for (const key_type& key : tree.range(tree.select(lo)->data, tree.select(lo + k - 1)->data))
+			out.push_back(key.first);
+	}
+
+	// _Private Methods
+
+	//
+	// Public Constructors
+	//
+
+	template<typename T, typename T_Height>
+	inline QuantileWindow<T, T_Height>::QuantileWindow(std::size_t capacity)
+	{
+		if (capacity == 0 || capacity > USHRT_MAX)
+			throw std::invalid_argument("QuantileWindow: capacity must be in [1, 65535]");
+
+		ring.resize(capacity);
+		tree.reuse_nodes(); // a full window erases one node per push: the insert takes it back
+	}
+
+	// _Public Constructors
+
+	//
+	// Public Methods
+	//
+
+	template<typename T, typename T_Height>
+	inline void QuantileWindow<T, T_Height>::push(const T& sample)
+	{
+		if (size() == ring.size())
+			expire(1);
+
+		ring[next % ring.size()] = sample;
+		tree.insert(key_type(sample, next));
+		++next;
+	}
+
+	template<typename T, typename T_Height>
+	inline void QuantileWindow<T, T_Height>::expire(std::size_t count)
+	{
+		for (; count > 0 && first != next; --count, ++first)
+			tree.erase(key_type(ring[first % ring.size()], first));
+	}
+
+	template<typename T, typename T_Height>
+	inline std::size_t QuantileWindow<T, T_Height>::size() const
+	{
+		return static_cast<std::size_t>(next - first);
+	}
+
+	template<typename T, typename T_Height>
+	inline std::size_t QuantileWindow<T, T_Height>::capacity() const
+	{
+		return ring.size();
+	}
+
+	template<typename T, typename T_Height>
+	inline bool QuantileWindow<T, T_Height>::empty() const
+	{
+		return first == next;
+	}
+
+	template<typename T, typename T_Height>
+	inline const T& QuantileWindow<T, T_Height>::quantile(double q) const
+	{
+		if (empty())
+			throw std::out_of_range("QuantileWindow: empty window");
+
+		q = std::min(1.0, std::max(0.0, q));
+		return select(static_cast<std::size_t>(q * (size() - 1)));
+	}
+
+	template<typename T, typename T_Height>
+	inline const T& QuantileWindow<T, T_Height>::select(std::size_t index) const
+	{
+		const typename tree_type::Node* node = tree.select(index);
+		if (node == nullptr)
+			throw std::out_of_range("QuantileWindow: rank out of range");
+
+		return node->data.first;
+	}
+
+	template<typename T, typename T_Height>
+	inline void QuantileWindow<T, T_Height>::top_k(std::size_t k, std::vector<T>& out) const
+	{
+		k = std::min(k, size());
+		Export(size() - k, k, out);
+		std::reverse(out.begin(), out.end());
+	}
+
+	template<typename T, typename T_Height>
+	inline void QuantileWindow<T, T_Height>::bottom_k(std::size_t k, std::vector<T>& out) const
+	{
+		Export(0, std::min(k, size()), out);
+	}
+
+	template<typename T, typename T_Height>
+	inline void QuantileWindow<T, T_Height>::clear()
+	{
+		tree.clear();
+		first = next;
+	}
+
+	// _Public Methods
+}
@@ -0,0 +1,133 @@
+#pragma once
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+namespace Tree
+{
+	// Background Thread That Frees Retired Trees: retire() takes a tree (or anything with clear_step(budget))
+	// by move in O(1), the worker frees it budget nodes at a time and yields in between.
+	// Tree::Reclaimer reclaimer; reclaimer.retire(tree.detach());
+	class Reclaimer
+	{
+	private:
+		std::deque<std::function<bool(std::size_t)>> queue; // clear_step() of each retired tree
+		std::size_t pending_ = 0;                          // retired, not yet freed
+		std::size_t budget;
+		bool stop = false;
+
+		mutable std::mutex lock;
+		std::condition_variable wake, done;
+		std::thread worker;
+
+		void Run();
+
+	public: // Constructors
+		explicit Reclaimer(std::size_t budget = 4096);
+
+		Reclaimer(const Reclaimer&) = delete;
+		Reclaimer& operator=(const Reclaimer&) = delete;
+
+		// Frees Everything Still Queued, Then Joins
+		~Reclaimer();
+
+	public: // Methods
+		template<typename Owner>
+		void retire(Owner tree);
+
+		// Block Until Every Retired Tree Is Freed
+		void drain();
+
+		std::size_t pending() const;
+	};
+
+	//
+	// Private Methods
+	//
+
+	inline void Reclaimer::Run()
+	{
+		for (;;)
+		{
+			std::function<bool(std::size_t)> job;
+			{
+				std::unique_lock<std::mutex> guard(lock);
+				wake.wait(guard, [this]() { return stop || !queue.empty(); });
+				if (queue.empty())
+					return;
+
+				job = std::move(queue.front());
+				queue.pop_front();
+			}
+
+			while (!job(budget))
+				std::this_thread::yield();
+			job = nullptr; // the tree itself goes here, on this thread
+
+			{
+				std::lock_guard<std::mutex> guard(lock);
+				--pending_;
+			}
+			done.notify_all();
+		}
+	}
+
+	// _Private Methods
+
+	//
+	// Public Constructors
+	//
+
+	inline Reclaimer::Reclaimer(std::size_t budget)
+		: budget(budget == 0 ? 1 : budget), worker(&Reclaimer::Run, this)
+	{
+	}
+
+	inline Reclaimer::~Reclaimer()
+	{
+		{
+			std::lock_guard<std::mutex> guard(lock);
+			stop = true;
+		}
+		wake.notify_one();
+		worker.join();
+	}
+
+	// _Public Constructors
+
+	//
+	// Public Methods
+	//
+
+	template<typename Owner>
+	inline void Reclaimer::retire(Owner tree)
+	{
+		// std::function copies its target: the tree is shared, never copied
+		std::shared_ptr<Owner> owned = std::make_shared<Owner>(std::move(tree));
+		{
+			std::lock_guard<std::mutex> guard(lock);
+			queue.emplace_back([owned](std::size_t budget) { return owned->clear_step(budget); });
+			++pending_;
+		}
+		wake.notify_one();
+	}
+
+	inline void Reclaimer::drain()
+	{
+		std::unique_lock<std::mutex> guard(lock);
+		done.wait(guard, [this]() { return pending_ == 0; });
+	}
+
+	inline std::size_t Reclaimer::pending() const
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		return pending_;
+	}
+
+	// _Public Methods
+}
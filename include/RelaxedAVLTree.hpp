@@ -0,0 +1,232 @@
+#pragma once
+#include "AVLTree.hpp"
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+namespace Tree
+{
+	// Write-Buffered AVLTree: insert/erase only queue, rebalance() or the first read applies the queue
+	// (and a write, once max_pending operations are queued); rebalance_step() applies it a slice at a time.
+	// The tree holds at most 65535 elements: queued inserts of new keys past that are dropped, reported
+	// by rebalance() / rebalance_step() and counted by dropped()
+	template<typename T, typename T_Height = unsigned char>
+	class RelaxedAVLTree : protected AVLTree<T, T_Height>
+	{
+	public:
+		static constexpr std::size_t max_pending = std::size_t(1) << 16;
+
+	private:
+		using Base = AVLTree<T, T_Height>;
+
+		std::vector<std::pair<T, bool>> pending; // (data, insert?) in arrival order
+		std::size_t applied = 0;                 // pending[0, applied) is already in the tree (rebalance_step())
+		std::size_t dropped_ = 0;
+
+		// Insert / Erase By Descent; false: a new key that did not fit
+		bool Apply(const std::pair<T, bool>& op);
+
+	public:
+		using Node = typename Base::Node;
+		using iterator = typename Base::iterator;
+		using const_iterator = typename Base::const_iterator;
+
+	public: // Constructors
+		RelaxedAVLTree() = default;
+
+	public: // Methods
+		// Queue Insert (no descent, no rotation)
+		void insert(const T& data);
+
+		// Queue Erase (no descent, no rotation)
+		void erase(const T& data);
+
+		// Apply Every Queued Operation, Tree Is AVL-Balanced Again (a big queue is merged in one
+		// flatten + rebuild pass, O(n + m), cheaper than m descents). Returns the inserts dropped
+		std::size_t rebalance();
+
+		// Apply At Most budget Queued Operations, Oldest First, By Regular Descents: the tree is balanced
+		// after every call, the queue shrinks by budget. true when it is empty; dropped: inserts dropped
+		bool rebalance_step(std::size_t budget, std::size_t* dropped = nullptr);
+
+		// Number Of Queued Operations
+		std::size_t pending_size() const;
+
+		// Queued Inserts Of New Keys Dropped Because The Tree Was Full, Since Construction
+		// (the only record of the ones dropped by a rebalance() a read or a write ran)
+		std::size_t dropped() const;
+
+		// Reads: rebalance() first
+		const Node* find(const T& data);
+		unsigned short size();
+		unsigned int distance(const T& element1, const T& element2);
+		NODISCARD iterator begin();
+		NODISCARD iterator end();
+
+		void clear();
+	};
+
+	template<typename T, typename T_Height>
+	constexpr std::size_t RelaxedAVLTree<T, T_Height>::max_pending;
+
+	//
+	// Private Methods
+	//
+
+	template<typename T, typename T_Height>
+	inline bool RelaxedAVLTree<T, T_Height>::Apply(const std::pair<T, bool>& op)
+	{
+		if (!op.second)
+			Base::erase(op.first);
+		else if (Base::size() == USHRT_MAX && Base::find(op.first) == nullptr)
+			return false;
+		else
+			Base::insert(op.first);
+
+		return true;
+	}
+
+	// _Private Methods
+
+	//
+	// Public Methods
+	//
+
+	template<typename T, typename T_Height>
+	inline void RelaxedAVLTree<T, T_Height>::insert(const T& data)
+	{
+		pending.emplace_back(data, true);
+		if (pending_size() >= max_pending)
+			rebalance();
+	}
+
+	template<typename T, typename T_Height>
+	inline void RelaxedAVLTree<T, T_Height>::erase(const T& data)
+	{
+		pending.emplace_back(data, false);
+		if (pending_size() >= max_pending)
+			rebalance();
+	}
+
+	template<typename T, typename T_Height>
+	inline std::size_t RelaxedAVLTree<T, T_Height>::rebalance()
+	{
+		pending.erase(pending.begin(), pending.begin() + applied);
+		applied = 0;
+		if (pending.empty())
+			return 0;
+
+		// the last operation on a key wins
+		std::stable_sort(pending.begin(), pending.end(),
+			[](const std::pair<T, bool>& a, const std::pair<T, bool>& b) { return a.first < b.first; });
+
+		std::vector<std::pair<T, bool>> ops;
+		ops.reserve(pending.size());
+		for (std::size_t i = 0; i < pending.size(); ++i)
+		{
+			if (i + 1 == pending.size() || pending[i].first != pending[i + 1].first)
+				ops.push_back(pending[i]);
+		}
+		pending.clear();
+
+		std::size_t dropped = 0;
+
+		// a few operations on a big tree: regular descents are cheaper than a rebuild
+		// (erases first: keys are unique in ops, so the order between them does not matter)
+		if (ops.size() * 16 < Base::size())
+		{
+			for (const std::pair<T, bool>& op : ops)
+			{
+				if (!op.second)
+					Apply(op);
+			}
+			for (const std::pair<T, bool>& op : ops)
+			{
+				if (op.second && !Apply(op))
+					++dropped;
+			}
+		}
+		else
+			dropped = Base::MergeSorted(ops);
+
+		dropped_ += dropped;
+		return dropped;
+	}
+
+	template<typename T, typename T_Height>
+	inline bool RelaxedAVLTree<T, T_Height>::rebalance_step(std::size_t budget, std::size_t* dropped)
+	{
+		std::size_t lost = 0;
+		for (; budget > 0 && applied < pending.size(); --budget, ++applied)
+			lost += !Apply(pending[applied]);
+
+		dropped_ += lost;
+		if (dropped != nullptr)
+			*dropped = lost;
+
+		// the applied prefix goes once it is half the buffer: O(1) amortized per operation
+		if (applied == pending.size() || applied * 2 > pending.size())
+		{
+			pending.erase(pending.begin(), pending.begin() + applied);
+			applied = 0;
+		}
+		return pending.empty();
+	}
+
+	template<typename T, typename T_Height>
+	inline std::size_t RelaxedAVLTree<T, T_Height>::pending_size() const
+	{
+		return pending.size() - applied;
+	}
+
+	template<typename T, typename T_Height>
+	inline std::size_t RelaxedAVLTree<T, T_Height>::dropped() const
+	{
+		return dropped_;
+	}
+
+	template<typename T, typename T_Height>
+	inline const typename RelaxedAVLTree<T, T_Height>::Node* RelaxedAVLTree<T, T_Height>::find(const T& data)
+	{
+		rebalance();
+		return Base::find(data);
+	}
+
+	template<typename T, typename T_Height>
+	inline unsigned short RelaxedAVLTree<T, T_Height>::size()
+	{
+		rebalance();
+		return Base::size();
+	}
+
+	template<typename T, typename T_Height>
+	inline unsigned int RelaxedAVLTree<T, T_Height>::distance(const T& element1, const T& element2)
+	{
+		rebalance();
+		return Base::distance(element1, element2);
+	}
+
+	template<typename T, typename T_Height>
+	inline typename RelaxedAVLTree<T, T_Height>::iterator RelaxedAVLTree<T, T_Height>::begin()
+	{
+		rebalance();
+		return Base::begin();
+	}
+
+	template<typename T, typename T_Height>
+	inline typename RelaxedAVLTree<T, T_Height>::iterator RelaxedAVLTree<T, T_Height>::end()
+	{
+		rebalance();
+		return Base::end();
+	}
+
+	template<typename T, typename T_Height>
+	inline void RelaxedAVLTree<T, T_Height>::clear()
+	{
+		pending.clear();
+		applied = 0;
+		Base::clear();
+	}
+
+	// _Public Methods
+}
@@ -0,0 +1,314 @@
+#pragma once
+#include "AVLTree.hpp"
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <utility>
+#include <vector>
+
+namespace Tree
+{
+	// Key-Range Sharded AVLTree: shard i holds [bounds[i - 1], bounds[i]), each shard has its own lock,
+	// so writers to different ranges do not wait for each other. Shards split above max_shard elements
+	// and merge with a neighbour when both together fall under max_shard / 4
+	template<typename T, typename T_Height = unsigned char>
+	class ShardedAVLTree
+	{
+	public:
+		using tree_type = AVLTree<T, T_Height>;
+
+		static constexpr std::size_t default_shard = std::size_t(1) << 12;
+		static constexpr std::size_t largest_shard = std::size_t(1) << 15; // room below the 65535 of one AVLTree
+
+	private:
+		// One Range: MergeSorted moves halves between shards in O(n)
+		struct Shard : tree_type
+		{
+			using tree_type::MergeSorted;
+			std::mutex lock;
+		};
+
+		std::vector<std::unique_ptr<Shard>> shards;
+		std::vector<T> bounds; // bounds[i]: first key of shards[i + 1]
+		std::size_t max_shard;
+
+		// shared: route + lock one shard; exclusive: split / merge (changes shards and bounds)
+		mutable std::shared_timed_mutex directory;
+
+		// Index Of The Shard Holding data, O(log shards)
+		std::size_t Route(const T& data) const;
+
+		// Split shards[index] At Its Median (exclusive lock held)
+		void Split(std::size_t index);
+
+		// Move shards[index + 1] Into shards[index] (exclusive lock held)
+		void Merge(std::size_t index);
+
+		// Split / Merge Around data If The Shard Still Needs It (takes the exclusive lock)
+		void Rebalance(const T& data);
+
+	public: // Constructors
+		explicit ShardedAVLTree(std::size_t max_shard = default_shard);
+
+		// Start With The Given Split Points (sorted, unique): bounds.size() + 1 shards
+		explicit ShardedAVLTree(std::vector<T> bounds, std::size_t max_shard = default_shard);
+
+		// shards hold locks
+		ShardedAVLTree(const ShardedAVLTree&) = delete;
+		ShardedAVLTree& operator=(const ShardedAVLTree&) = delete;
+
+	public: // Methods
+		// Lock Only The Shard Of data
+		bool insert(const T& data);
+		bool erase(const T& data);
+
+		// No Node Pointer: the shard may change as soon as its lock is released
+		bool contains(const T& data) const;
+
+		// Sum Of The Shard Sizes, Every Shard Locked (a consistent count)
+		std::size_t size() const;
+
+		// Number Of Elements Between Two Present Elements, Across Shards (0 if one is missing)
+		std::size_t distance(const T& element1, const T& element2) const;
+
+		// Visit Every Element In Order, Every Shard Locked
+		template<typename F>
+		void for_each(F f) const;
+
+		std::size_t shard_count() const;
+	};
+
+	// odr-used by std::min (C++14 needs the definitions)
+	template<typename T, typename T_Height>
+	constexpr std::size_t ShardedAVLTree<T, T_Height>::default_shard;
+
+	template<typename T, typename T_Height>
+	constexpr std::size_t ShardedAVLTree<T, T_Height>::largest_shard;
+
+	//
+	// Private Methods
+	//
+
+	// Index Of The Shard Holding data, O(log shards)
+	template<typename T, typename T_Height>
+	inline std::size_t ShardedAVLTree<T, T_Height>::Route(const T& data) const
+	{
+		return static_cast<std::size_t>(std::upper_bound(bounds.begin(), bounds.end(), data) - bounds.begin());
+	}
+
+	// Split shards[index] At Its Median (exclusive lock held)
+	template<typename T, typename T_Height>
+	inline void ShardedAVLTree<T, T_Height>::Split(std::size_t index)
+	{
+		Shard& left = *shards[index];
+		std::size_t half = left.size() / 2, rank = 0;
+
+		std::vector<std::pair<T, bool>> moved;
+		moved.reserve(left.size() - half);
+		for (auto it = left.cursor_begin(); it != left.cursor_end(); ++it, ++rank)
+		{
+			if (rank >= half)
+				moved.emplace_back(*it, true);
+		}
+
+		std::unique_ptr<Shard> right(new Shard());
+		right->MergeSorted(moved);
+		T first = moved.front().first;
+
+		for (std::pair<T, bool>& op : moved)
+			op.second = false;
+		left.MergeSorted(moved);
+
+		shards.insert(shards.begin() + index + 1, std::move(right));
+		bounds.insert(bounds.begin() + index, std::move(first));
+	}
+
+	// Move shards[index + 1] Into shards[index] (exclusive lock held)
+	template<typename T, typename T_Height>
+	inline void ShardedAVLTree<T, T_Height>::Merge(std::size_t index)
+	{
+		Shard& right = *shards[index + 1];
+
+		std::vector<std::pair<T, bool>> moved;
+		moved.reserve(right.size());
+		for (auto it = right.cursor_begin(); it != right.cursor_end(); ++it)
+			moved.emplace_back(*it, true);
+		shards[index]->MergeSorted(moved);
+
+		shards.erase(shards.begin() + index + 1);
+		bounds.erase(bounds.begin() + index);
+	}
+
+	// Split / Merge Around data If The Shard Still Needs It (takes the exclusive lock)
+	template<typename T, typename T_Height>
+	inline void ShardedAVLTree<T, T_Height>::Rebalance(const T& data)
+	{
+		std::unique_lock<std::shared_timed_mutex> lock(directory);
+
+		// another thread may have rebalanced while this one waited
+		std::size_t index = Route(data);
+		if (shards[index]->size() > max_shard)
+		{
+			Split(index);
+			return;
+		}
+
+		if (shards.size() < 2)
+			return;
+
+		// the smaller neighbour is the cheaper one to move
+		std::size_t with = index == 0 ? 1
+			: index + 1 == shards.size() ? index - 1
+			: shards[index - 1]->size() < shards[index + 1]->size() ? index - 1 : index + 1;
+
+		if (shards[index]->size() + shards[with]->size() <= max_shard / 4)
+			Merge(std::min(index, with));
+	}
+
+	// _Private Methods
+
+	//
+	// Public Constructors
+	//
+
+	template<typename T, typename T_Height>
+	inline ShardedAVLTree<T, T_Height>::ShardedAVLTree(std::size_t max_shard)
+		: max_shard(std::max<std::size_t>(4, std::min(max_shard, largest_shard)))
+	{
+		shards.emplace_back(new Shard());
+	}
+
+	template<typename T, typename T_Height>
+	inline ShardedAVLTree<T, T_Height>::ShardedAVLTree(std::vector<T> bounds, std::size_t max_shard)
+		: bounds(std::move(bounds)), max_shard(std::max<std::size_t>(4, std::min(max_shard, largest_shard)))
+	{
+		for (std::size_t i = 0; i <= this->bounds.size(); ++i)
+			shards.emplace_back(new Shard());
+	}
+
+	// _Public Constructors
+
+	//
+	// Public Methods
+	//
+
+	template<typename T, typename T_Height>
+	inline bool ShardedAVLTree<T, T_Height>::insert(const T& data)
+	{
+		bool inserted, split;
+		{
+			std::shared_lock<std::shared_timed_mutex> route(directory);
+			Shard& shard = *shards[Route(data)];
+			std::lock_guard<std::mutex> lock(shard.lock);
+			inserted = shard.insert(data);
+			split = shard.size() > max_shard;
+		}
+
+		if (split)
+			Rebalance(data);
+
+		return inserted;
+	}
+
+	template<typename T, typename T_Height>
+	inline bool ShardedAVLTree<T, T_Height>::erase(const T& data)
+	{
+		bool erased, merge = false;
+		{
+			std::shared_lock<std::shared_timed_mutex> route(directory);
+			std::size_t index = Route(data);
+			Shard& shard = *shards[index];
+			std::lock_guard<std::mutex> lock(shard.lock);
+			erased = shard.erase(data);
+
+			// checked when the shard shrinks past max_shard / 8 (or empties), not on every erase below it:
+			// a small shard next to a big one would otherwise take the exclusive lock each time
+			merge = erased && shards.size() > 1 && (shard.size() == max_shard / 8 || shard.size() == 0);
+		}
+
+		if (merge)
+			Rebalance(data);
+
+		return erased;
+	}
+
+	template<typename T, typename T_Height>
+	inline bool ShardedAVLTree<T, T_Height>::contains(const T& data) const
+	{
+		std::shared_lock<std::shared_timed_mutex> route(directory);
+		Shard& shard = *shards[Route(data)];
+		std::lock_guard<std::mutex> lock(shard.lock);
+		return shard.find(data) != nullptr;
+	}
+
+	template<typename T, typename T_Height>
+	inline std::size_t ShardedAVLTree<T, T_Height>::size() const
+	{
+		std::shared_lock<std::shared_timed_mutex> route(directory);
+		std::vector<std::unique_lock<std::mutex>> locks;
+		for (const std::unique_ptr<Shard>& shard : shards)
+			locks.emplace_back(shard->lock);
+
+		std::size_t total = 0;
+		for (const std::unique_ptr<Shard>& shard : shards)
+			total += shard->size();
+
+		return total;
+	}
+
+	template<typename T, typename T_Height>
+	inline std::size_t ShardedAVLTree<T, T_Height>::distance(const T& element1, const T& element2) const
+	{
+		if (!(element1 < element2))
+			return 0;
+
+		std::shared_lock<std::shared_timed_mutex> route(directory);
+		std::size_t first = Route(element1), last = Route(element2);
+
+		// shards in index order, as everywhere: no lock cycle
+		std::vector<std::unique_lock<std::mutex>> locks;
+		for (std::size_t i = first; i <= last; ++i)
+			locks.emplace_back(shards[i]->lock);
+
+		const Shard& left = *shards[first];
+		const Shard& right = *shards[last];
+		if (left.find(element1) == nullptr || right.find(element2) == nullptr)
+			return 0;
+
+		if (first == last)
+			return left.distance(element1, element2);
+
+		// element1 .. end of its shard, whole shards in between, start of the last shard .. element2
+		std::size_t result = left.distance(element1, *left.rbegin()) + 1 + right.distance(*right.begin(), element2);
+		for (std::size_t i = first + 1; i < last; ++i)
+			result += shards[i]->size();
+
+		return result;
+	}
+
+	template<typename T, typename T_Height>
+	template<typename F>
+	inline void ShardedAVLTree<T, T_Height>::for_each(F f) const
+	{
+		std::shared_lock<std::shared_timed_mutex> route(directory);
+		std::vector<std::unique_lock<std::mutex>> locks;
+		for (const std::unique_ptr<Shard>& shard : shards)
+			locks.emplace_back(shard->lock);
+
+		for (const std::unique_ptr<Shard>& shard : shards)
+		{
+			for (auto it = shard->cursor_begin(); it != shard->cursor_end(); ++it)
+				f(*it);
+		}
+	}
+
+	template<typename T, typename T_Height>
+	inline std::size_t ShardedAVLTree<T, T_Height>::shard_count() const
+	{
+		std::shared_lock<std::shared_timed_mutex> route(directory);
+		return shards.size();
+	}
+
+	// _Public Methods
+}
@@ -0,0 +1,322 @@
+#pragma once
+#include "AVLTree.hpp"
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Tree
+{
+	// String Key: first 8 bytes normalized (big-endian) into the node + view of the full string
+	class PrefixKey
+	{
+	private:
+		std::uint64_t prefix;
+		const char* ptr;
+		std::size_t len;
+
+		// Load Up To 8 Bytes As A Big-Endian Number (zero padded)
+		static std::uint64_t LoadPrefix(const char* ptr, std::size_t len)
+		{
+			std::uint64_t prefix = 0;
+			for (std::size_t i = 0; i < sizeof(prefix); ++i)
+				prefix = (prefix << 8) | (i < len ? static_cast<unsigned char>(ptr[i]) : 0u);
+
+			return prefix;
+		}
+
+	public:
+		PrefixKey() : prefix(0), ptr(""), len(0) {}
+		PrefixKey(const char* ptr, std::size_t len) : prefix(LoadPrefix(ptr, len)), ptr(ptr), len(len) {}
+		explicit PrefixKey(const std::string& str) : PrefixKey(str.data(), str.size()) {}
+
+		const char* data() const { return ptr; }
+		std::size_t size() const { return len; }
+		std::string str() const { return std::string(ptr, len); }
+
+		// Compare Prefixes, Full Strings Only On A Tie
+		int compare(const PrefixKey& other) const
+		{
+			if (prefix != other.prefix)
+				return prefix < other.prefix ? -1 : 1;
+
+			std::size_t common = len < other.len ? len : other.len;
+			if (common > sizeof(prefix))
+			{
+				int result = std::memcmp(ptr + sizeof(prefix), other.ptr + sizeof(prefix), common - sizeof(prefix));
+				if (result != 0)
+					return result;
+			}
+
+			return len < other.len ? -1 : (len > other.len ? 1 : 0);
+		}
+
+		bool operator==(const PrefixKey& other) const { return compare(other) == 0; }
+		bool operator!=(const PrefixKey& other) const { return compare(other) != 0; }
+		bool operator<(const PrefixKey& other) const { return compare(other) < 0; }
+		bool operator>(const PrefixKey& other) const { return compare(other) > 0; }
+		bool operator<=(const PrefixKey& other) const { return compare(other) <= 0; }
+		bool operator>=(const PrefixKey& other) const { return compare(other) >= 0; }
+	};
+
+	// Arena For String Bytes (erased strings stay as dead bytes until StringAVLTree::reclaim() or clear())
+	class StringPool
+	{
+	private:
+		std::vector<std::unique_ptr<char[]>> chunks;
+		char* current = nullptr;
+		std::size_t left = 0;
+		std::size_t chunk_size;
+		std::size_t capacity_ = 0;
+		std::size_t dead_ = 0;
+
+	public:
+		explicit StringPool(std::size_t chunk_size = 64 * 1024) : chunk_size(chunk_size) {}
+
+		StringPool(const StringPool&) = delete;
+		StringPool& operator=(const StringPool&) = delete;
+
+		// The Source Keeps No Pointer Into The Chunks It Gave Away
+		StringPool(StringPool&& other) noexcept
+			: chunks(std::move(other.chunks)), current(other.current), left(other.left), chunk_size(other.chunk_size),
+			capacity_(other.capacity_), dead_(other.dead_)
+		{
+			other.chunks.clear();
+			other.current = nullptr;
+			other.left = other.capacity_ = other.dead_ = 0;
+		}
+
+		StringPool& operator=(StringPool&& other) noexcept
+		{
+			if (this != &other)
+			{
+				chunks = std::move(other.chunks);
+				current = other.current;
+				left = other.left;
+				chunk_size = other.chunk_size;
+				capacity_ = other.capacity_;
+				dead_ = other.dead_;
+
+				other.chunks.clear();
+				other.current = nullptr;
+				other.left = other.capacity_ = other.dead_ = 0;
+			}
+			return *this;
+		}
+
+		// Copy len Bytes Into The Arena
+		const char* store(const char* data, std::size_t len)
+		{
+			if (len > left)
+			{
+				std::size_t new_chunk = len > chunk_size ? len : chunk_size;
+				chunks.emplace_back(new char[new_chunk]);
+				dead_ += left; // the tail of the old chunk is never used
+				current = chunks.back().get();
+				left = new_chunk;
+				capacity_ += new_chunk;
+			}
+
+			char* stored = current;
+			std::memcpy(stored, data, len);
+			current += len;
+			left -= len;
+			return stored;
+		}
+
+		// Give Back The Last store() (no-op for any other string)
+		void rollback(const char* data, std::size_t len)
+		{
+			if (data + len == current)
+			{
+				current -= len;
+				left += len;
+			}
+		}
+
+		// Count len Bytes Of An Erased String As Dead
+		void release(std::size_t len)
+		{
+			dead_ += len;
+		}
+
+		void clear()
+		{
+			chunks.clear();
+			current = nullptr;
+			left = capacity_ = dead_ = 0;
+		}
+
+		std::size_t capacity() const { return capacity_; }
+		std::size_t dead() const { return dead_; }
+	};
+
+	template<typename T_Height = unsigned char>
+	class StringAVLTree
+	{
+	private:
+		AVLTree<PrefixKey, T_Height> tree;
+		StringPool pool;
+
+	public:
+		using Node = typename AVLTree<PrefixKey, T_Height>::Node;
+		using iterator = typename AVLTree<PrefixKey, T_Height>::iterator;
+		using const_iterator = typename AVLTree<PrefixKey, T_Height>::const_iterator;
+
+	public: // Constructors
+		StringAVLTree() = default;
+		StringAVLTree(const std::initializer_list<std::string>& init_list);
+
+		StringAVLTree(const StringAVLTree<T_Height>& other);
+		StringAVLTree(StringAVLTree<T_Height>&& other) = default;
+
+		StringAVLTree<T_Height>& operator=(const StringAVLTree<T_Height>& other);
+		StringAVLTree<T_Height>& operator=(StringAVLTree<T_Height>&& other) = default;
+
+	public: // Methods
+		bool insert(const char* data, std::size_t len);
+		bool insert(const std::string& data);
+		bool erase(const std::string& data);
+		const Node* find(const std::string& data) const&;
+		void clear();
+		unsigned short size() const;
+		unsigned int distance(const std::string& element1, const std::string& element2) const;
+
+		// Bytes Reserved By The String Arena / Of Those, Bytes Of Erased Strings
+		std::size_t pool_capacity() const;
+		std::size_t pool_dead() const;
+
+		// Copy The Live Strings Into A New Arena, Freeing The Dead Bytes: O(n log n), and like a copy it
+		// invalidates every node pointer and iterator. Never done behind the caller's back (erase() only counts)
+		void reclaim();
+
+		NODISCARD iterator begin() const;
+		NODISCARD iterator end() const;
+	};
+
+	//
+	// Public Constructors
+	//
+
+	template<typename T_Height>
+	inline StringAVLTree<T_Height>::StringAVLTree(const std::initializer_list<std::string>& init_list)
+	{
+		for (const std::string& value : init_list)
+		{
+			insert(value);
+		}
+	}
+
+	template<typename T_Height>
+	inline StringAVLTree<T_Height>::StringAVLTree(const StringAVLTree<T_Height>& other)
+	{
+		for (const PrefixKey& key : other.tree)
+		{
+			insert(key.data(), key.size());
+		}
+	}
+
+	template<typename T_Height>
+	inline StringAVLTree<T_Height>& StringAVLTree<T_Height>::operator=(const StringAVLTree<T_Height>& other)
+	{
+		if (this != &other)
+		{
+			StringAVLTree<T_Height> copy(other);
+			*this = std::move(copy);
+		}
+
+		return *this;
+	}
+
+	// _Public Constructors
+
+	//
+	// Public Methods
+	//
+
+	template<typename T_Height>
+	inline bool StringAVLTree<T_Height>::insert(const char* data, std::size_t len)
+	{
+		const char* stored = pool.store(data, len);
+		if (tree.insert(PrefixKey(stored, len)))
+			return true;
+
+		pool.rollback(stored, len);
+		return false;
+	}
+
+	template<typename T_Height>
+	inline bool StringAVLTree<T_Height>::insert(const std::string& data)
+	{
+		return insert(data.data(), data.size());
+	}
+
+	template<typename T_Height>
+	inline bool StringAVLTree<T_Height>::erase(const std::string& data)
+	{
+		if (!tree.erase(PrefixKey(data)))
+			return false;
+
+		pool.release(data.size());
+		return true;
+	}
+
+	template<typename T_Height>
+	inline const typename StringAVLTree<T_Height>::Node* StringAVLTree<T_Height>::find(const std::string& data) const&
+	{
+		return tree.find(PrefixKey(data));
+	}
+
+	template<typename T_Height>
+	inline void StringAVLTree<T_Height>::clear()
+	{
+		tree.clear();
+		pool.clear();
+	}
+
+	template<typename T_Height>
+	inline unsigned short StringAVLTree<T_Height>::size() const
+	{
+		return tree.size();
+	}
+
+	template<typename T_Height>
+	inline unsigned int StringAVLTree<T_Height>::distance(const std::string& element1, const std::string& element2) const
+	{
+		return tree.distance(PrefixKey(element1), PrefixKey(element2));
+	}
+
+	template<typename T_Height>
+	inline std::size_t StringAVLTree<T_Height>::pool_capacity() const
+	{
+		return pool.capacity();
+	}
+
+	template<typename T_Height>
+	inline std::size_t StringAVLTree<T_Height>::pool_dead() const
+	{
+		return pool.dead();
+	}
+
+	template<typename T_Height>
+	inline void StringAVLTree<T_Height>::reclaim()
+	{
+		StringAVLTree<T_Height> copy(*this);
+		*this = std::move(copy);
+	}
+
+	template<typename T_Height>
+	inline typename StringAVLTree<T_Height>::iterator StringAVLTree<T_Height>::begin() const
+	{
+		return tree.begin();
+	}
+
+	template<typename T_Height>
+	inline typename StringAVLTree<T_Height>::iterator StringAVLTree<T_Height>::end() const
+	{
+		return tree.end();
+	}
+
+	// _Public Methods
+}
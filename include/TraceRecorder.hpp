@@ -0,0 +1,359 @@
+#pragma once
+#include "AVLTree.hpp"
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+namespace Tree
+{
+	// Operations A Trace Records
+	enum class TraceOp : std::uint8_t
+	{
+		insert, erase, find, distance, iterate
+	};
+
+	// One Trace Record, As Read Back By TraceReader
+	template<typename T>
+	struct TraceRecord
+	{
+		TraceOp op;
+		std::uint16_t thread;     // small id, in order of the first record of each thread
+		std::uint64_t nanoseconds; // since the recorder was created
+		T key;
+		T key2;                   // distance() only
+	};
+
+	// Compact Binary Trace: header (magic, version, key size, key kind), then per call
+	// op u8 | thread u16 | nanoseconds u64 | key | key2 (distance only); T is written byte for byte.
+	// Shared by any number of trees and threads (one lock per record, buffered writes)
+	template<typename T>
+	class TraceRecorder
+	{
+		static_assert(std::is_trivially_copyable<T>::value, "traces store keys byte for byte");
+
+	public:
+		static constexpr std::uint32_t magic = 0x52545641; // "AVTR"
+		static constexpr std::uint16_t version = 1;
+
+		// 'i' signed integer, 'u' unsigned integer, 'f' floating point, 'b' anything else
+		static constexpr char key_kind = std::is_floating_point<T>::value ? 'f'
+			: std::is_integral<T>::value ? (std::is_signed<T>::value ? 'i' : 'u') : 'b';
+
+	private:
+		std::FILE* file;
+		std::vector<char> buffer;
+		std::unordered_map<std::thread::id, std::uint16_t> threads;
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		std::mutex lock;
+		bool failed = false; // a write failed: the trace on disk is incomplete
+
+		// Write buffer Out (false: a write failed, recorded in failed)
+		bool Flush();
+
+	public: // Constructors
+		// throws std::runtime_error if path cannot be created or the header cannot be written
+		explicit TraceRecorder(const std::string& path);
+
+		TraceRecorder(const TraceRecorder&) = delete;
+		TraceRecorder& operator=(const TraceRecorder&) = delete;
+
+		~TraceRecorder();
+
+	public: // Methods
+		void record(TraceOp op, const T& key, const T* key2 = nullptr);
+
+		// Write Out What Is Buffered; false if any write of this recorder failed so far
+		// (record() does not throw on a failed write, the trace is incomplete from there on)
+		bool flush();
+	};
+
+	// Whole Trace In Memory (throws std::runtime_error on a bad header or a key size other than sizeof(T))
+	template<typename T>
+	class TraceReader
+	{
+	private:
+		static bool ReadHeader(std::FILE* file, std::uint16_t& key_bytes, char& key_kind);
+
+	public:
+		// Key Size + Kind Of The Trace At path, Without Reading It (to pick T)
+		static bool peek(const std::string& path, std::uint16_t& key_bytes, char& key_kind);
+
+		// throws std::runtime_error if path cannot be opened too
+		static std::vector<TraceRecord<T>> read(const std::string& path);
+	};
+
+	// Recording Policy Of RecordingAVLTree That Records Nothing (the default: no cost)
+	template<typename T>
+	struct NoRecorder
+	{
+		void record(TraceOp, const T&, const T* = nullptr) { }
+	};
+
+	// AVLTree That Logs insert / erase / find / distance / iteration Starts To A Recorder (nullptr: not recording).
+	// Tree::RecordingAVLTree<int, unsigned char, Tree::NoAugment, Tree::TraceRecorder<int>>
+	template<typename T, typename T_Height = unsigned char, typename Augment = NoAugment, typename Recorder = NoRecorder<T>, typename Balancing = AVLBalancing>
+	class RecordingAVLTree : public AVLTree<T, T_Height, Augment, Balancing>
+	{
+	private:
+		using Base = AVLTree<T, T_Height, Augment, Balancing>;
+
+		Recorder* recorder = nullptr;
+
+	public:
+		using Node = typename Base::Node;
+		using iterator = typename Base::iterator;
+		using cursor = typename Base::cursor;
+
+	public: // Constructors
+		using Base::Base;
+
+	public: // Methods
+		// Start (or, with nullptr, stop) Recording; the recorder must outlive the recording
+		void record_to(Recorder* recorder);
+
+		bool insert(const T& data);
+		bool erase(const T& data);
+		const Node* find(const T& data) const&;
+		unsigned int distance(const T& element1, const T& element2) const;
+
+		// an iteration is recorded where it starts, with the smallest key (or a value-initialized one);
+		// unlike AVLTree::cursor_begin() this one may throw what the recorder throws
+		NODISCARD iterator begin() const;
+		NODISCARD iterator cbegin() const;
+		NODISCARD cursor cursor_begin() const;
+	};
+
+	//
+	// TraceRecorder
+	//
+
+	template<typename T>
+	constexpr std::uint32_t TraceRecorder<T>::magic;
+
+	template<typename T>
+	constexpr std::uint16_t TraceRecorder<T>::version;
+
+	template<typename T>
+	constexpr char TraceRecorder<T>::key_kind;
+
+	template<typename T>
+	inline TraceRecorder<T>::TraceRecorder(const std::string& path)
+		: file(std::fopen(path.c_str(), "wb"))
+	{
+		if (file == nullptr)
+			throw std::runtime_error("TraceRecorder: cannot create " + path);
+
+		const std::uint16_t key_bytes = sizeof(T);
+		if (std::fwrite(&magic, sizeof(magic), 1, file) != 1 || std::fwrite(&version, sizeof(version), 1, file) != 1
+			|| std::fwrite(&key_bytes, sizeof(key_bytes), 1, file) != 1 || std::fwrite(&key_kind, sizeof(key_kind), 1, file) != 1)
+		{
+			std::fclose(file);
+			throw std::runtime_error("TraceRecorder: cannot write the header of " + path);
+		}
+
+		buffer.reserve(std::size_t(1) << 16);
+	}
+
+	template<typename T>
+	inline TraceRecorder<T>::~TraceRecorder()
+	{
+		Flush();
+		std::fclose(file);
+	}
+
+	template<typename T>
+	inline bool TraceRecorder<T>::Flush()
+	{
+		if (std::fwrite(buffer.data(), 1, buffer.size(), file) != buffer.size() || std::fflush(file) != 0)
+			failed = true;
+
+		buffer.clear();
+		return !failed;
+	}
+
+	template<typename T>
+	inline void TraceRecorder<T>::record(TraceOp op, const T& key, const T* key2)
+	{
+		const std::uint64_t nanoseconds = static_cast<std::uint64_t>(
+			std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+
+		std::lock_guard<std::mutex> guard(lock);
+		auto thread = threads.emplace(std::this_thread::get_id(), static_cast<std::uint16_t>(threads.size())).first->second;
+
+		char record[1 + sizeof(thread) + sizeof(nanoseconds) + 2 * sizeof(T)];
+		char* end = record;
+		*end++ = static_cast<char>(op);
+		std::memcpy(end, &thread, sizeof(thread));
+		end += sizeof(thread);
+		std::memcpy(end, &nanoseconds, sizeof(nanoseconds));
+		end += sizeof(nanoseconds);
+		std::memcpy(end, &key, sizeof(T));
+		end += sizeof(T);
+		if (op == TraceOp::distance)
+		{
+			std::memcpy(end, key2, sizeof(T));
+			end += sizeof(T);
+		}
+
+		buffer.insert(buffer.end(), record, end);
+		if (buffer.size() >= (std::size_t(1) << 16))
+			Flush();
+	}
+
+	template<typename T>
+	inline bool TraceRecorder<T>::flush()
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		return Flush();
+	}
+
+	// _TraceRecorder
+
+	//
+	// TraceReader
+	//
+
+	template<typename T>
+	inline bool TraceReader<T>::ReadHeader(std::FILE* file, std::uint16_t& key_bytes, char& key_kind)
+	{
+		std::uint32_t magic = 0;
+		std::uint16_t version = 0;
+		return std::fread(&magic, sizeof(magic), 1, file) == 1 && magic == TraceRecorder<T>::magic
+			&& std::fread(&version, sizeof(version), 1, file) == 1 && version == TraceRecorder<T>::version
+			&& std::fread(&key_bytes, sizeof(key_bytes), 1, file) == 1
+			&& std::fread(&key_kind, sizeof(key_kind), 1, file) == 1;
+	}
+
+	template<typename T>
+	inline bool TraceReader<T>::peek(const std::string& path, std::uint16_t& key_bytes, char& key_kind)
+	{
+		std::FILE* file = std::fopen(path.c_str(), "rb");
+		if (file == nullptr)
+			return false;
+
+		bool ok = ReadHeader(file, key_bytes, key_kind);
+		std::fclose(file);
+
+		return ok;
+	}
+
+	template<typename T>
+	inline std::vector<TraceRecord<T>> TraceReader<T>::read(const std::string& path)
+	{
+		// one open for the header and the records: the file cannot change in between
+		std::FILE* file = std::fopen(path.c_str(), "rb");
+		if (file == nullptr)
+			throw std::runtime_error("TraceReader: cannot open " + path);
+
+		std::uint16_t key_bytes;
+		char key_kind;
+		if (!ReadHeader(file, key_bytes, key_kind) || key_bytes != sizeof(T))
+		{
+			std::fclose(file);
+			throw std::runtime_error("TraceReader: not a trace of " + std::to_string(sizeof(T)) + "-byte keys: " + path);
+		}
+
+		std::vector<TraceRecord<T>> records;
+		TraceRecord<T> record;
+		std::uint8_t op;
+		while (std::fread(&op, sizeof(op), 1, file) == 1
+			&& std::fread(&record.thread, sizeof(record.thread), 1, file) == 1
+			&& std::fread(&record.nanoseconds, sizeof(record.nanoseconds), 1, file) == 1
+			&& std::fread(&record.key, sizeof(T), 1, file) == 1)
+		{
+			record.op = static_cast<TraceOp>(op);
+			record.key2 = record.key;
+			if (record.op == TraceOp::distance && std::fread(&record.key2, sizeof(T), 1, file) != 1)
+				break;
+
+			records.push_back(record);
+		}
+		std::fclose(file);
+
+		return records;
+	}
+
+	// _TraceReader
+
+	//
+	// RecordingAVLTree
+	//
+
+	template<typename T, typename T_Height, typename Augment, typename Recorder, typename Balancing>
+	inline void RecordingAVLTree<T, T_Height, Augment, Recorder, Balancing>::record_to(Recorder* recorder)
+	{
+		this->recorder = recorder;
+	}
+
+	template<typename T, typename T_Height, typename Augment, typename Recorder, typename Balancing>
+	inline bool RecordingAVLTree<T, T_Height, Augment, Recorder, Balancing>::insert(const T& data)
+	{
+		if (recorder)
+			recorder->record(TraceOp::insert, data);
+
+		return Base::insert(data);
+	}
+
+	template<typename T, typename T_Height, typename Augment, typename Recorder, typename Balancing>
+	inline bool RecordingAVLTree<T, T_Height, Augment, Recorder, Balancing>::erase(const T& data)
+	{
+		if (recorder)
+			recorder->record(TraceOp::erase, data);
+
+		return Base::erase(data);
+	}
+
+	template<typename T, typename T_Height, typename Augment, typename Recorder, typename Balancing>
+	inline const typename RecordingAVLTree<T, T_Height, Augment, Recorder, Balancing>::Node* RecordingAVLTree<T, T_Height, Augment, Recorder, Balancing>::find(const T& data) const&
+	{
+		if (recorder)
+			recorder->record(TraceOp::find, data);
+
+		return Base::find(data);
+	}
+
+	template<typename T, typename T_Height, typename Augment, typename Recorder, typename Balancing>
+	inline unsigned int RecordingAVLTree<T, T_Height, Augment, Recorder, Balancing>::distance(const T& element1, const T& element2) const
+	{
+		if (recorder)
+			recorder->record(TraceOp::distance, element1, &element2);
+
+		return Base::distance(element1, element2);
+	}
+
+	template<typename T, typename T_Height, typename Augment, typename Recorder, typename Balancing>
+	inline typename RecordingAVLTree<T, T_Height, Augment, Recorder, Balancing>::iterator RecordingAVLTree<T, T_Height, Augment, Recorder, Balancing>::begin() const
+	{
+		return cbegin();
+	}
+
+	template<typename T, typename T_Height, typename Augment, typename Recorder, typename Balancing>
+	inline typename RecordingAVLTree<T, T_Height, Augment, Recorder, Balancing>::iterator RecordingAVLTree<T, T_Height, Augment, Recorder, Balancing>::cbegin() const
+	{
+		iterator first = Base::cbegin();
+		if (recorder)
+			recorder->record(TraceOp::iterate, this->root ? *first : T());
+
+		return first;
+	}
+
+	template<typename T, typename T_Height, typename Augment, typename Recorder, typename Balancing>
+	inline typename RecordingAVLTree<T, T_Height, Augment, Recorder, Balancing>::cursor RecordingAVLTree<T, T_Height, Augment, Recorder, Balancing>::cursor_begin() const
+	{
+		cursor first = Base::cursor_begin();
+		if (recorder)
+			recorder->record(TraceOp::iterate, this->root ? *first : T());
+
+		return first;
+	}
+
+	// _RecordingAVLTree
+}
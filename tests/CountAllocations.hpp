@@ -0,0 +1,42 @@
+#pragma once
+#include "AVLTree.hpp"
+#include <atomic>
+#include <cstddef>
+
+// Node Allocation Counter: nodes inherit the augmentation, so its operator new / delete see every
+// node the tree allocates or frees. Atomic: a Reclaimer frees on its own thread.
+// Shared by the node reuse and incremental clear tests
+struct CountAllocations : Tree::NoAugment
+{
+	static std::atomic<std::size_t>& allocations()
+	{
+		static std::atomic<std::size_t> count(0);
+		return count;
+	}
+
+	static std::atomic<std::size_t>& frees()
+	{
+		static std::atomic<std::size_t> count(0);
+		return count;
+	}
+
+	// Nodes Allocated And Not Freed Yet
+	static long live()
+	{
+		return static_cast<long>(allocations()) - static_cast<long>(frees());
+	}
+
+	static void* operator new(std::size_t bytes)
+	{
+		++allocations();
+		return ::operator new(bytes);
+	}
+
+	static void operator delete(void* pointer)
+	{
+		++frees();
+		::operator delete(pointer);
+	}
+};
+
+using CountedTree = Tree::AVLTree<int, unsigned char, CountAllocations>;
@@ -0,0 +1,180 @@
+#pragma once
+#include "AVLTree.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Differential Replay: a byte string decoded as operations, applied to Tree::AVLTree<int> and std::set<int>
+// side by side; after every step the invariants of the tree are checked and the results compared.
+// Shared by the libFuzzer target (fuzz/) and the randomized test (tests/differential_test.cpp)
+namespace Differential
+{
+	enum Op : std::uint8_t
+	{
+		Insert, Erase, Find, InsertNear, FindFrom, Distance, RankBatch, Range,
+		CopyAssign, MoveAssign, Swap, CompactStep, Compact, Clear,
+		count
+	};
+
+	// 3 bytes per step: op, key (little endian, 0..key_range-1 so that keys collide often)
+	static const std::size_t step_bytes = 3;
+	static const int key_range = 1024;
+
+	inline int Key(const std::uint8_t* step)
+	{
+		return (step[1] | (step[2] << 8)) % key_range;
+	}
+
+	inline std::string Where(std::size_t step, const char* what)
+	{
+		return "step " + std::to_string(step) + ": " + what;
+	}
+
+	// Replay data On Both Containers: "" If Everything Matched, Else The First Difference
+	inline std::string Replay(const std::uint8_t* data, std::size_t size)
+	{
+		Tree::AVLTree<int> tree;
+		std::set<int> expected;
+		Tree::AVLTree<int>::finger hint;
+
+		for (std::size_t step = 0; step + step_bytes <= size; step += step_bytes)
+		{
+			const std::uint8_t* bytes = data + step;
+			const int key = Key(bytes);
+			const std::size_t index = step / step_bytes;
+
+			switch (bytes[0] % count)
+			{
+			case Insert:
+				if (tree.insert(key) != expected.insert(key).second)
+					return Where(index, "insert() result");
+				break;
+
+			case Erase:
+				if (tree.erase(key) != (expected.erase(key) == 1))
+					return Where(index, "erase() result");
+				break;
+
+			case Find:
+			{
+				const Tree::AVLTree<int>::Node* node = tree.find(key);
+				if ((node != nullptr) != (expected.count(key) == 1) || (node && node->data != key))
+					return Where(index, "find() result");
+				break;
+			}
+
+			case InsertNear:
+				if (tree.insert_near(hint, key) != expected.insert(key).second)
+					return Where(index, "insert_near() result");
+				break;
+
+			case FindFrom:
+			{
+				const Tree::AVLTree<int>::Node* node = tree.find_from(hint, key);
+				if ((node != nullptr) != (expected.count(key) == 1))
+					return Where(index, "find_from() result");
+				break;
+			}
+
+			case Distance:
+			{
+				// second key: the bytes of the next step, wrapped
+				const int other = Key(data + (step + step_bytes) % (size - 2));
+				unsigned int want = 0;
+				if (key < other && expected.count(key) && expected.count(other))
+					want = static_cast<unsigned int>(std::distance(expected.find(key), expected.find(other)));
+
+				std::vector<unsigned int> batch;
+				tree.distance_batch({ { key, other } }, batch);
+				if (tree.distance(key, other) != want || batch[0] != want)
+					return Where(index, "distance() / distance_batch()");
+				break;
+			}
+
+			case RankBatch:
+			{
+				std::vector<int> keys = { key / 2, key, key + 1, key + key_range / 2 };
+				std::vector<std::size_t> ranks;
+				tree.rank_batch(keys, ranks);
+				for (std::size_t i = 0; i < keys.size(); ++i)
+				{
+					if (ranks[i] != static_cast<std::size_t>(std::distance(expected.begin(), expected.lower_bound(keys[i]))))
+						return Where(index, "rank_batch()");
+				}
+				break;
+			}
+
+			case Range:
+			{
+				const int hi = key + bytes[1] % 64;
+				std::size_t want = static_cast<std::size_t>(std::distance(expected.lower_bound(key), expected.upper_bound(hi)));
+				Tree::AVLTree<int>::range_type view = tree.range(key, hi);
+				if (view.size() != want || static_cast<std::size_t>(std::distance(view.begin(), view.end())) != want)
+					return Where(index, "range()");
+				break;
+			}
+
+			case CopyAssign:
+			{
+				Tree::AVLTree<int> copy;
+				copy.insert(key);
+				copy = tree;
+				if (!copy.check_invariants() || copy != tree)
+					return Where(index, "copy assignment");
+				tree = copy;
+				break;
+			}
+
+			case MoveAssign:
+			{
+				Tree::AVLTree<int> moved(std::move(tree));
+				tree = std::move(moved);
+				break;
+			}
+
+			case Swap:
+			{
+				Tree::AVLTree<int> other;
+				tree.swap(other);
+				if (tree.size() != 0)
+					return Where(index, "swap()");
+				tree.swap(other);
+				break;
+			}
+
+			case CompactStep:
+				tree.compact_step(1 + bytes[1] % 16);
+				break;
+
+			case Compact:
+				if (bytes[2] % 8 == 0)
+					tree.compact();
+				break;
+
+			case Clear:
+				// rare: most traces should grow big trees
+				if (bytes[1] == 0 && bytes[2] % 4 == 0)
+				{
+					tree.clear();
+					expected.clear();
+				}
+				break;
+			}
+
+			if (!tree.check_invariants())
+				return Where(index, "check_invariants()");
+			if (tree.size() != expected.size())
+				return Where(index, "size()");
+		}
+
+		if (!std::equal(expected.begin(), expected.end(), tree.begin()) || std::distance(tree.begin(), tree.end()) != static_cast<std::ptrdiff_t>(expected.size()))
+			return "contents differ at the end";
+
+		return "";
+	}
+}
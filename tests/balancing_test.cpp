@@ -0,0 +1,134 @@
+#include "AVLTree.hpp"
+#include <gtest/gtest.h>
+#include <iterator>
+#include <random>
+#include <set>
+#include <vector>
+
+template<typename Balancing>
+using PolicyTree = Tree::AVLTree<int, unsigned char, Tree::NoAugment, Balancing>;
+
+// counts restructurings (a double rotation is one call)
+struct CountRotations : Tree::NoAugment
+{
+    static std::size_t count;
+
+    template<typename Node>
+    static void rotate(const Node*) { ++count; }
+};
+std::size_t CountRotations::count = 0;
+
+// insert / erase churn against std::set, invariants of the policy after every step
+template<typename Balancing>
+static void Churn(unsigned int seed)
+{
+    PolicyTree<Balancing> tree;
+    std::set<int> expected;
+    std::mt19937 gen(seed);
+
+    for (int step = 0; step < 6000; ++step)
+    {
+        int key = static_cast<int>(gen() % 2000);
+        if (gen() % 5 < 3)
+            ASSERT_EQ(tree.insert(key), expected.insert(key).second);
+        else
+            ASSERT_EQ(tree.erase(key), expected.erase(key) == 1);
+
+        ASSERT_TRUE(tree.check_invariants()) << "step " << step;
+        ASSERT_EQ(tree.size(), expected.size());
+    }
+
+    ASSERT_TRUE(std::equal(expected.begin(), expected.end(), tree.begin()));
+    ASSERT_EQ(std::distance(tree.rbegin(), tree.rend()), static_cast<std::ptrdiff_t>(expected.size()));
+
+    // order statistics do not depend on the policy
+    std::vector<int> keys(expected.begin(), expected.end());
+    std::vector<std::size_t> ranks;
+    tree.rank_batch(keys, ranks);
+    for (std::size_t i = 0; i < keys.size(); ++i)
+        ASSERT_EQ(ranks[i], i);
+    if (keys.size() > 1)
+    {
+        ASSERT_EQ(tree.distance(keys.front(), keys.back()), keys.size() - 1);
+    }
+}
+
+// sorted runs, copies and the balanced rebuild of compact()
+template<typename Balancing>
+static void Rebuilds()
+{
+    PolicyTree<Balancing> tree;
+    for (int i = 0; i < 5000; ++i)
+        ASSERT_TRUE(tree.insert(i));
+    ASSERT_TRUE(tree.check_invariants());
+
+    for (int i = 0; i < 5000; i += 3)
+        ASSERT_TRUE(tree.erase(i));
+    ASSERT_TRUE(tree.check_invariants());
+
+    PolicyTree<Balancing> copy(tree);
+    ASSERT_TRUE(copy.check_invariants());
+    ASSERT_TRUE(copy == tree);
+
+    tree.compact();
+    ASSERT_TRUE(tree.check_invariants());
+
+    // the tree keeps working after the rebuild
+    for (int i = 0; i < 5000; i += 3)
+        ASSERT_TRUE(tree.insert(i));
+    for (int i = 1; i < 5000; i += 2)
+        ASSERT_TRUE(tree.erase(i));
+    ASSERT_TRUE(tree.check_invariants());
+    ASSERT_EQ(tree.size(), 2500u);
+}
+
+
+TEST(AVLTreeBalancing, AVLChurn)
+{
+    for (unsigned int seed = 0; seed < 4; ++seed)
+        Churn<Tree::AVLBalancing>(seed);
+    Rebuilds<Tree::AVLBalancing>();
+}
+
+
+TEST(AVLTreeBalancing, WAVLChurn)
+{
+    for (unsigned int seed = 0; seed < 4; ++seed)
+        Churn<Tree::WAVLBalancing>(seed);
+    Rebuilds<Tree::WAVLBalancing>();
+}
+
+
+TEST(AVLTreeBalancing, WeightBalancedChurn)
+{
+    for (unsigned int seed = 0; seed < 4; ++seed)
+        Churn<Tree::WeightBalancing>(seed);
+    Rebuilds<Tree::WeightBalancing>();
+}
+
+
+TEST(AVLTreeBalancing, WAVLInsertOnlyIsAVL)
+{
+    // without erases a WAVL tree is an AVL tree: rank = height, at most one restructuring per insert
+    Tree::AVLTree<int, unsigned char, CountRotations, Tree::WAVLBalancing> tree;
+    std::mt19937 gen(7);
+    for (int i = 0; i < 4000; ++i)
+    {
+        std::size_t before = CountRotations::count;
+        tree.insert(static_cast<int>(gen() % 100000));
+        ASSERT_LE(CountRotations::count - before, 1u);
+    }
+    ASSERT_TRUE(tree.check_invariants());
+}
+
+
+TEST(AVLTreeBalancing, RotationHookFires)
+{
+    CountRotations::count = 0;
+    Tree::AVLTree<int, unsigned char, CountRotations> tree;
+    tree.insert(1);
+    tree.insert(2);
+    ASSERT_EQ(CountRotations::count, 0u);
+    tree.insert(3);
+    ASSERT_EQ(CountRotations::count, 1u);
+}
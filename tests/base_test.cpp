@@ -1,5 +1,7 @@
 #include "AVLTree.hpp"
 #include <gtest/gtest.h>
+#include <type_traits>
+#include <vector>
 
 
 TEST(AVLTreeTest, InsertElements) 
@@ -120,4 +122,128 @@ TEST(AVLTreeTest, DistanceAndLCA)
     ASSERT_EQ(tree.distance(3,7), 2);
     ASSERT_EQ(tree.distance(3,15), 4);
     ASSERT_EQ(tree.distance(5,5), 0);
-}
\ No newline at end of file
+}
+
+// ------------------- Compare -------------------
+TEST(AVLTreeTest, EqualContentsDifferentShapes)
+{
+    Tree::AVLTree<int> ascending, descending;
+    for(int i=1; i<=100; ++i) ascending.insert(i);
+    for(int i=100; i>=1; --i) descending.insert(i);
+
+    ASSERT_TRUE(ascending == descending);
+    ASSERT_EQ(ascending.compare(descending), 0);
+
+    descending.erase(50);
+    ASSERT_TRUE(ascending != descending);
+}
+
+
+TEST(AVLTreeTest, LexicographicCompare)
+{
+    Tree::AVLTree<int> a = {1, 2, 3}, b = {1, 2, 4}, c = {1, 2};
+    ASSERT_LT(a.compare(b), 0);
+    ASSERT_GT(b.compare(a), 0);
+    ASSERT_GT(a.compare(c), 0);
+    ASSERT_LT(c.compare(a), 0);
+    ASSERT_EQ(Tree::AVLTree<int>().compare(Tree::AVLTree<int>()), 0);
+}
+
+// ------------------- Copy / Move -------------------
+static_assert(std::is_nothrow_move_constructible<Tree::AVLTree<int>>::value, "vector growth must move trees");
+static_assert(std::is_nothrow_move_assignable<Tree::AVLTree<int>>::value, "move assignment must not throw");
+
+TEST(AVLTreeTest, CopyAssignReusesNodes)
+{
+    Tree::AVLTree<int> big, small = {7, 8, 9};
+    for(int i=0; i<500; ++i) big.insert(i * 3);
+
+    Tree::AVLTree<int> target = small;
+    target = big;
+    ASSERT_TRUE(target == big);
+    ASSERT_EQ(target.size(), 500);
+    ASSERT_EQ(target.distance(0, 1497), 499);
+
+    target = small;
+    ASSERT_TRUE(target == small);
+    ASSERT_EQ(target.size(), 3);
+
+    target = target;
+    ASSERT_TRUE(target == small);
+
+    target.insert(1);
+    ASSERT_EQ(small.size(), 3);
+    ASSERT_EQ(target.size(), 4);
+}
+
+
+TEST(AVLTreeTest, MoveLeavesEmptyTree)
+{
+    Tree::AVLTree<int> source = {1, 2, 3};
+    Tree::AVLTree<int> moved(std::move(source));
+    ASSERT_EQ(moved.size(), 3);
+    ASSERT_EQ(source.size(), 0);
+    ASSERT_EQ(source.find(1), nullptr);
+
+    source = std::move(moved);
+    ASSERT_EQ(source.size(), 3);
+    ASSERT_EQ(moved.size(), 0);
+}
+
+
+TEST(AVLTreeTest, VectorGrowthKeepsTrees)
+{
+    std::vector<Tree::AVLTree<int>> shards;
+    for(int i=0; i<100; ++i)
+    {
+        shards.emplace_back();
+        shards.back().insert(i);
+        shards.back().insert(i + 1000);
+    }
+
+    for(int i=0; i<100; ++i)
+    {
+        ASSERT_EQ(shards[i].size(), 2);
+        ASSERT_NE(shards[i].find(i), nullptr);
+    }
+}
+
+// ------------------- Key Types -------------------
+struct NoDefaultKey
+{
+    int value;
+
+    explicit NoDefaultKey(int value) : value(value) { }
+    bool operator<(const NoDefaultKey& other) const { return value < other.value; }
+    bool operator>(const NoDefaultKey& other) const { return value > other.value; }
+    bool operator==(const NoDefaultKey& other) const { return value == other.value; }
+    bool operator!=(const NoDefaultKey& other) const { return value != other.value; }
+};
+
+TEST(AVLTreeTest, KeyWithoutDefaultConstructor)
+{
+    Tree::AVLTree<NoDefaultKey> tree;
+    for(int i=0; i<50; ++i) ASSERT_TRUE(tree.insert(NoDefaultKey(i)));
+    ASSERT_FALSE(tree.insert(NoDefaultKey(7)));
+    ASSERT_EQ(tree.size(), 50);
+    ASSERT_NE(tree.find(NoDefaultKey(49)), nullptr);
+    ASSERT_TRUE(tree.erase(NoDefaultKey(0)));
+    ASSERT_EQ(tree.find(NoDefaultKey(0)), nullptr);
+}
+
+
+TEST(AVLTreeTest, ArithmeticKeys)
+{
+    Tree::AVLTree<double> doubles;
+    for(int i=100; i>0; --i) ASSERT_TRUE(doubles.insert(i * 0.5));
+    ASSERT_FALSE(doubles.insert(25.0));
+    ASSERT_EQ(doubles.size(), 100);
+    ASSERT_NE(doubles.find(0.5), nullptr);
+    ASSERT_EQ(doubles.find(0.25), nullptr);
+    ASSERT_EQ(doubles.distance(0.5, 50.0), 99);
+
+    Tree::AVLTree<unsigned long long> wide = {~0ull, 0ull, 1ull << 40};
+    ASSERT_EQ(*wide.begin(), 0ull);
+    ASSERT_EQ(*wide.rbegin(), ~0ull);
+    ASSERT_NE(wide.find(1ull << 40), nullptr);
+}
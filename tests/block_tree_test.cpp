@@ -0,0 +1,114 @@
+#include "BlockAVLTree.hpp"
+#include <gtest/gtest.h>
+#include <random>
+#include <set>
+#include <vector>
+
+class BlockAVLTree_int : public ::testing::Test
+{
+protected:
+    Tree::BlockAVLTree<int, 4> obj; // small blocks: many splits and block removals
+};
+
+
+TEST_F(BlockAVLTree_int, InsertFindErase)
+{
+    for (int v : {10, 20, 5, 15, 25, 1, 7, 30})
+        ASSERT_TRUE(obj.insert(v));
+    ASSERT_FALSE(obj.insert(15));
+    ASSERT_EQ(obj.size(), 8);
+
+    ASSERT_NE(obj.find(7), nullptr);
+    ASSERT_EQ(*obj.find(7), 7);
+    ASSERT_EQ(obj.find(8), nullptr);
+
+    ASSERT_TRUE(obj.erase(7));
+    ASSERT_FALSE(obj.erase(7));
+    ASSERT_EQ(std::vector<int>(obj.begin(), obj.end()), (std::vector<int>{1, 5, 10, 15, 20, 25, 30}));
+}
+
+
+TEST_F(BlockAVLTree_int, RankAndDistance)
+{
+    Tree::BlockAVLTree<int, 4> tree = {10, 5, 15, 3, 7};
+    ASSERT_EQ(tree.distance(3, 7), 2);
+    ASSERT_EQ(tree.distance(3, 15), 4);
+    ASSERT_EQ(tree.distance(5, 5), 0);
+    ASSERT_EQ(tree.distance(3, 8), 0);
+    ASSERT_EQ(tree.rank(8), 3);
+}
+
+
+TEST_F(BlockAVLTree_int, RandomAgainstStdSet)
+{
+    std::set<int> expected;
+    std::mt19937 gen(31);
+
+    for (int i = 0; i < 30000; ++i)
+    {
+        int v = gen() % 3000;
+        if (gen() % 3 == 0)
+            ASSERT_EQ(expected.erase(v) == 1, obj.erase(v));
+        else
+            ASSERT_EQ(expected.insert(v).second, obj.insert(v));
+
+        if (i % 1000 == 0)
+        {
+            int probe = gen() % 3000;
+            ASSERT_EQ(std::distance(expected.begin(), expected.lower_bound(probe)), obj.rank(probe));
+        }
+    }
+
+    ASSERT_EQ(expected.size(), obj.size());
+    ASSERT_EQ(std::vector<int>(expected.begin(), expected.end()), std::vector<int>(obj.begin(), obj.end()));
+
+    std::vector<int> visited;
+    Tree::BlockAVLTree<int, 4> copy = obj;
+    obj.clear();
+    copy.for_each([&visited](int v) { visited.push_back(v); });
+    ASSERT_EQ(std::vector<int>(expected.begin(), expected.end()), visited);
+    ASSERT_EQ(0, obj.size());
+}
+
+
+TEST(BlockAVLTree_churn, MemoryPerKeyAfterChurn)
+{
+    // fill, then erase most keys at random: underfull blocks are merged, not kept
+    Tree::BlockAVLTree<int, 32> tree;
+    std::set<int> expected;
+    std::mt19937 gen(131);
+
+    for (int round = 0; round < 4; ++round)
+    {
+        for (int i = 0; i < 20000; ++i)
+        {
+            int v = gen() % 100000;
+            ASSERT_EQ(expected.insert(v).second, tree.insert(v));
+        }
+        while (expected.size() > 2000)
+        {
+            int v = gen() % 100000;
+            ASSERT_EQ(expected.erase(v) == 1, tree.erase(v));
+        }
+
+        ASSERT_EQ(std::vector<int>(expected.begin(), expected.end()), std::vector<int>(tree.begin(), tree.end()));
+        // every block at least half full: at most two key slots per key
+        ASSERT_LE(tree.block_count() * 16u, tree.size());
+        ASSERT_LE(tree.block_count() * tree.block_bytes() / tree.size(), 2 * tree.block_bytes() / 32);
+
+        int probe = gen() % 100000;
+        ASSERT_EQ(std::distance(expected.begin(), expected.lower_bound(probe)), tree.rank(probe));
+    }
+
+    while (!expected.empty())
+    {
+        ASSERT_TRUE(tree.erase(*expected.begin()));
+        expected.erase(expected.begin());
+        ASSERT_EQ(expected.size(), tree.size());
+        if (tree.size() >= 16)
+        {
+            ASSERT_LE(tree.block_count() * 16u, tree.size());
+        }
+    }
+    ASSERT_EQ(tree.block_count(), 0u);
+}
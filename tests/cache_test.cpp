@@ -0,0 +1,193 @@
+#include "AVLCache.hpp"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <list>
+#include <random>
+#include <set>
+#include <stdexcept>
+
+using Clock = std::chrono::steady_clock;
+
+class AVLCache_int : public ::testing::Test
+{
+protected:
+    Tree::AVLCache<int> obj{3};
+    Clock::time_point now = Clock::time_point(std::chrono::seconds(1));
+
+    std::set<int> contents() const
+    {
+        return std::set<int>(obj.begin(), obj.end());
+    }
+};
+
+
+TEST_F(AVLCache_int, EvictLeastRecent)
+{
+    for (int v : {1, 2, 3, 4})
+        obj.insert(v, now);
+
+    ASSERT_EQ(obj.size(), 3);
+    ASSERT_EQ(contents(), (std::set<int>{2, 3, 4}));
+    ASSERT_EQ(obj.lru()->data, 2);
+}
+
+
+TEST_F(AVLCache_int, FindAndDuplicateInsertTouch)
+{
+    for (int v : {1, 2, 3})
+        obj.insert(v, now);
+
+    ASSERT_NE(obj.find(1, now), nullptr);
+    ASSERT_FALSE(obj.insert(2, now));
+    ASSERT_TRUE(obj.insert(4, now));
+
+    ASSERT_EQ(contents(), (std::set<int>{1, 2, 4}));
+    ASSERT_EQ(obj.find(3, now), nullptr);
+}
+
+
+TEST_F(AVLCache_int, EraseUnlinks)
+{
+    for (int v : {1, 2, 3})
+        obj.insert(v, now);
+
+    ASSERT_TRUE(obj.erase(1));
+    ASSERT_EQ(obj.lru()->data, 2);
+    obj.insert(4, now);
+    obj.insert(5, now);
+    ASSERT_EQ(contents(), (std::set<int>{3, 4, 5}));
+
+    obj.clear();
+    ASSERT_EQ(obj.lru(), nullptr);
+    ASSERT_TRUE(obj.insert(1, now));
+}
+
+
+TEST(AVLCache_ttl, ExpireSweepsOldestFirst)
+{
+    Tree::AVLCache<int> obj(100, std::chrono::seconds(10));
+    Clock::time_point start = Clock::time_point(std::chrono::seconds(100));
+
+    for (int v = 0; v < 10; ++v)
+        obj.insert(v, start + std::chrono::seconds(v));
+
+    ASSERT_EQ(obj.find(0, start + std::chrono::seconds(10)), nullptr);
+    ASSERT_NE(obj.find(5, start + std::chrono::seconds(10)), nullptr);
+
+    ASSERT_EQ(obj.expire(start + std::chrono::seconds(14)), 5);
+    ASSERT_EQ(std::set<int>(obj.begin(), obj.end()), (std::set<int>{5, 6, 7, 8, 9}));
+    ASSERT_EQ(obj.expire(start + std::chrono::seconds(100)), 5);
+    ASSERT_EQ(obj.size(), 0);
+}
+
+
+TEST(AVLCache_ttl, ReinsertRenewsExpired)
+{
+    Tree::AVLCache<int> obj(100, std::chrono::seconds(10));
+    Clock::time_point start = Clock::time_point(std::chrono::seconds(100));
+
+    ASSERT_TRUE(obj.insert(1, start));
+    ASSERT_TRUE(obj.insert(2, start + std::chrono::seconds(5)));
+    ASSERT_FALSE(obj.insert(1, start + std::chrono::seconds(5)));
+
+    // expired, not swept: the insert renews it
+    ASSERT_TRUE(obj.insert(1, start + std::chrono::seconds(20)));
+    ASSERT_NE(obj.find(1, start + std::chrono::seconds(20)), nullptr);
+    ASSERT_EQ(obj.size(), 2);
+
+    // and moves it behind 2 in expiry order
+    ASSERT_EQ(obj.expire(start + std::chrono::seconds(25)), 1);
+    ASSERT_EQ(std::set<int>(obj.begin(), obj.end()), (std::set<int>{1}));
+    ASSERT_NE(obj.find(1, start + std::chrono::seconds(29)), nullptr);
+    ASSERT_EQ(obj.find(1, start + std::chrono::seconds(30)), nullptr);
+}
+
+
+TEST(AVLCache_ttl, UnsweptEntriesCountInSize)
+{
+    Tree::AVLCache<int> obj(100, std::chrono::seconds(10));
+    Clock::time_point start = Clock::time_point(std::chrono::seconds(100));
+
+    obj.insert(1, start);
+    obj.insert(2, start);
+    ASSERT_EQ(obj.find(1, start + std::chrono::seconds(10)), nullptr);
+    ASSERT_EQ(obj.size(), 2);
+    ASSERT_EQ(obj.expire(start + std::chrono::seconds(10)), 2);
+    ASSERT_EQ(obj.size(), 0);
+}
+
+
+// Eviction and the sweep erase through parent links: every shape of the tree is hit
+TEST(AVLCache_ttl, EvictAndSweepKeepTree)
+{
+    const unsigned short capacity = 1000;
+    Tree::AVLCache<int> obj(capacity, std::chrono::seconds(50));
+    Clock::time_point start = Clock::time_point(std::chrono::seconds(100));
+    std::mt19937 gen(280);
+
+    for (int i = 0; i < 20000; ++i)
+    {
+        Clock::time_point now = start + std::chrono::seconds(i / 20);
+        obj.insert(static_cast<int>(gen() % 5000), now);
+        if (i % 97 == 0)
+            obj.expire(now);
+
+        ASSERT_LE(obj.size(), capacity);
+        if (i % 101 == 0)
+        {
+            ASSERT_TRUE(obj.check_invariants());
+        }
+    }
+
+    ASSERT_TRUE(obj.check_invariants());
+    ASSERT_GT(obj.expire(start + std::chrono::seconds(10000)), 0u);
+    ASSERT_EQ(obj.size(), 0);
+    ASSERT_EQ(obj.begin(), obj.end());
+}
+
+
+TEST(AVLCache_ttl, ZeroCapacityRejected)
+{
+    ASSERT_THROW(Tree::AVLCache<int>(0), std::invalid_argument);
+}
+
+
+TEST(AVLCache_model, RandomAgainstList)
+{
+    const unsigned short capacity = 50;
+    Tree::AVLCache<int> obj(capacity);
+    std::list<int> model; // front = most recent
+    std::mt19937 gen(28);
+
+    for (int i = 0; i < 20000; ++i)
+    {
+        int v = gen() % 200;
+        auto it = std::find(model.begin(), model.end(), v);
+        switch (gen() % 3)
+        {
+        case 0:
+            ASSERT_EQ(it == model.end(), obj.insert(v));
+            if (it != model.end())
+                model.erase(it);
+            model.push_front(v);
+            if (model.size() > capacity)
+                model.pop_back();
+            break;
+        case 1:
+            ASSERT_EQ(it != model.end(), obj.find(v) != nullptr);
+            if (it != model.end())
+                model.splice(model.begin(), model, it);
+            break;
+        default:
+            ASSERT_EQ(it != model.end(), obj.erase(v));
+            if (it != model.end())
+                model.erase(it);
+        }
+
+        ASSERT_EQ(model.size(), obj.size());
+        if (!model.empty())
+        {
+            ASSERT_EQ(model.back(), obj.lru()->data);
+        }
+    }
+}
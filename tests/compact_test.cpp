@@ -0,0 +1,118 @@
+#include "AVLTree.hpp"
+#include <gtest/gtest.h>
+#include <random>
+#include <set>
+#include <string>
+
+
+static void ExpectSame(const Tree::AVLTree<int>& tree, const std::set<int>& reference)
+{
+    ASSERT_EQ(tree.size(), reference.size());
+    auto it = reference.begin();
+    for (int value : tree)
+        ASSERT_EQ(value, *it++);
+}
+
+
+TEST(AVLTree_compact, ContentsUnchanged)
+{
+    Tree::AVLTree<int> tree;
+    std::set<int> reference;
+    std::mt19937 gen(39);
+    for (int step = 0; step < 20000; ++step)
+    {
+        int key = static_cast<int>(gen() % 5000);
+        if (gen() % 3 == 0)
+        {
+            tree.erase(key);
+            reference.erase(key);
+        }
+        else
+        {
+            tree.insert(key);
+            reference.insert(key);
+        }
+    }
+
+    tree.compact();
+    ExpectSame(tree, reference);
+    ASSERT_EQ(tree.distance(*reference.begin(), *reference.rbegin()), reference.size() - 1);
+}
+
+
+TEST(AVLTree_compact, NodesAreContiguousBreadthFirst)
+{
+    Tree::AVLTree<int> tree;
+    std::mt19937 gen(39);
+    for (int i = 0; i < 3000; ++i)
+        tree.insert(static_cast<int>(gen()));
+    tree.compact();
+
+    using Node = Tree::AVLTree<int>::Node;
+    const Node* lowest = nullptr;
+    const Node* highest = nullptr;
+    for (auto it = tree.cursor_begin(); it != tree.cursor_end(); ++it)
+    {
+        const Node* node = tree.find(*it);
+        lowest = (lowest == nullptr || node < lowest ? node : lowest);
+        highest = (highest == nullptr || node > highest ? node : highest);
+    }
+    ASSERT_EQ(highest - lowest + 1, tree.size());
+}
+
+
+TEST(AVLTree_compact, ChangesBetweenSteps)
+{
+    Tree::AVLTree<int> tree;
+    std::set<int> reference;
+    for (int i = 0; i < 4000; ++i)
+    {
+        tree.insert(i * 3);
+        reference.insert(i * 3);
+    }
+
+    int steps = 0, key = 1;
+    while (!tree.compact_step(256))
+    {
+        ++steps;
+        if (steps % 2 == 0)
+        {
+            tree.insert(key);
+            reference.insert(key);
+            tree.erase(key * 3);
+            reference.erase(key * 3);
+            key += 7;
+        }
+        ASSERT_LT(steps, 10000);
+    }
+    ASSERT_GT(steps, 1);
+    ExpectSame(tree, reference);
+
+    // a second pass empties and frees the first block, later erases and clear() keep working
+    for (int i = 0; i < 500; ++i)
+    {
+        tree.erase(i * 3);
+        reference.erase(i * 3);
+    }
+    tree.compact();
+    ExpectSame(tree, reference);
+
+    Tree::AVLTree<int> moved(std::move(tree));
+    ExpectSame(moved, reference);
+    moved.clear();
+    ASSERT_EQ(moved.size(), 0);
+    ASSERT_TRUE(moved.compact_step(1));
+}
+
+
+TEST(AVLTree_compact, StringKeysMoved)
+{
+    Tree::AVLTree<std::string> tree;
+    for (int i = 0; i < 300; ++i)
+        tree.insert("key-" + std::to_string(i) + std::string(40, 'x'));
+
+    Tree::AVLTree<std::string> copy(tree);
+    tree.compact();
+    ASSERT_TRUE(tree == copy);
+    ASSERT_NE(tree.find("key-7" + std::string(40, 'x')), nullptr);
+}
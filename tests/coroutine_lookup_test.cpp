@@ -0,0 +1,102 @@
+#include "CoroutineLookup.hpp"
+#include <gtest/gtest.h>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#if ((defined(_MSVC_LANG) && _MSVC_LANG >= 202002L) || __cplusplus >= 202002L) && defined(__cpp_impl_coroutine)
+
+TEST(CoroutineLookup, InterleavedMatchesFind)
+{
+    Tree::AVLTree<int> tree;
+    std::mt19937 gen(50);
+    for (int i = 0; i < 30000; ++i)
+        tree.insert(static_cast<int>(gen() % 100000));
+
+    std::vector<int> keys;
+    for (int i = 0; i < 5000; ++i)
+        keys.push_back(static_cast<int>(gen() % 100000));
+
+    for (std::size_t width : {1, 7, 32, 200})
+    {
+        std::vector<const Tree::AVLTree<int>::Node*> found;
+        Tree::find_interleaved(tree, keys, found, width);
+        ASSERT_EQ(found.size(), keys.size());
+        for (std::size_t i = 0; i < keys.size(); ++i)
+            ASSERT_EQ(found[i], tree.find(keys[i])) << "width " << width << " key " << keys[i];
+    }
+}
+
+
+TEST(CoroutineLookup, TaskByHandAndEmptyTree)
+{
+    Tree::AVLTree<int> tree = {1, 2, 3, 4, 5, 6, 7};
+
+    // one resume per level: 3 levels for the deepest key of a tree of 7
+    auto task = Tree::find_async(tree, 7);
+    int steps = 0;
+    while (!task.done())
+    {
+        task.resume();
+        ++steps;
+    }
+    ASSERT_NE(task.result(), nullptr);
+    ASSERT_EQ(task.result()->data, 7);
+    ASSERT_EQ(steps, 4); // 3 levels + the return
+
+    auto missing = Tree::find_async(tree, 100);
+    while (!missing.done())
+        missing.resume();
+    ASSERT_EQ(missing.result(), nullptr);
+
+    Tree::AVLTree<int> empty;
+    std::vector<const Tree::AVLTree<int>::Node*> found;
+    Tree::find_interleaved(empty, std::vector<int>{1, 2}, found);
+    ASSERT_EQ(found, (std::vector<const Tree::AVLTree<int>::Node*>{nullptr, nullptr}));
+}
+
+
+TEST(CoroutineLookup, SchedulerAcrossTreesAndStrings)
+{
+    std::vector<Tree::AVLTree<std::string>> trees(3);
+    for (int i = 0; i < 300; ++i)
+        trees[i % 3].insert("key" + std::to_string(i));
+
+    Tree::LookupScheduler<Tree::AVLTree<std::string>> scheduler(8);
+    std::vector<const Tree::AVLTree<std::string>::Node*> out(600, nullptr);
+    for (int i = 0; i < 600; ++i)
+        scheduler.submit(trees[i % 3], "key" + std::to_string(i % 400), &out[i]);
+    ASSERT_EQ(scheduler.pending(), 600u);
+    scheduler.run();
+    ASSERT_EQ(scheduler.pending(), 0u);
+
+    for (int i = 0; i < 600; ++i)
+        ASSERT_EQ(out[i], trees[i % 3].find("key" + std::to_string(i % 400))) << i;
+}
+
+
+// comparisons that throw: the exception comes out of result()
+struct Fragile
+{
+    int value;
+    bool operator<(const Fragile& other) const
+    {
+        if (other.value < 0 || value < 0)
+            throw std::runtime_error("fragile");
+        return value < other.value;
+    }
+    bool operator>(const Fragile& other) const { return other < *this; }
+    bool operator==(const Fragile& other) const { return value == other.value; }
+};
+
+TEST(CoroutineLookup, ComparisonErrorsReachTheCaller)
+{
+    Tree::AVLTree<Fragile> tree = {Fragile{1}, Fragile{2}, Fragile{3}};
+    auto task = Tree::find_async(tree, Fragile{-1});
+    while (!task.done())
+        task.resume();
+    ASSERT_THROW(task.result(), std::runtime_error);
+}
+
+#endif
@@ -0,0 +1,81 @@
+#include "Differential.hpp"
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+// random traces from fixed seeds: the same operations on every run
+static std::vector<std::uint8_t> Trace(unsigned int seed, std::size_t steps, int bias)
+{
+    std::mt19937 gen(seed);
+    std::vector<std::uint8_t> trace;
+    for (std::size_t i = 0; i < steps; ++i)
+    {
+        std::uint8_t op = static_cast<std::uint8_t>(gen());
+        int key = static_cast<int>(gen() % Differential::key_range);
+
+        // bias 1: mostly inserts of ascending keys, bias 2: insert / erase churn
+        if (bias == 1 && gen() % 4 != 0)
+        {
+            op = gen() % 2 ? Differential::Insert : Differential::InsertNear;
+            key = static_cast<int>(i % Differential::key_range);
+        }
+        else if (bias == 2 && gen() % 2 != 0)
+            op = gen() % 2 ? Differential::Insert : Differential::Erase;
+
+        trace.push_back(op);
+        trace.push_back(static_cast<std::uint8_t>(key & 0xff));
+        trace.push_back(static_cast<std::uint8_t>(key >> 8));
+    }
+    return trace;
+}
+
+
+TEST(Differential, RandomTraces)
+{
+    for (unsigned int seed = 0; seed < 60; ++seed)
+    {
+        std::vector<std::uint8_t> trace = Trace(seed, 1500, 0);
+        ASSERT_EQ(Differential::Replay(trace.data(), trace.size()), "") << "seed " << seed;
+    }
+}
+
+
+TEST(Differential, AscendingTraces)
+{
+    for (unsigned int seed = 100; seed < 120; ++seed)
+    {
+        std::vector<std::uint8_t> trace = Trace(seed, 2500, 1);
+        ASSERT_EQ(Differential::Replay(trace.data(), trace.size()), "") << "seed " << seed;
+    }
+}
+
+
+TEST(Differential, ChurnTraces)
+{
+    for (unsigned int seed = 200; seed < 230; ++seed)
+    {
+        std::vector<std::uint8_t> trace = Trace(seed, 2500, 2);
+        ASSERT_EQ(Differential::Replay(trace.data(), trace.size()), "") << "seed " << seed;
+    }
+}
+
+
+TEST(Differential, ShortAndEmptyInputs)
+{
+    const std::uint8_t bytes[] = { Differential::Insert, 5, 0, Differential::Distance, 5, 0, Differential::Erase };
+    for (std::size_t size = 0; size <= sizeof(bytes); ++size)
+        ASSERT_EQ(Differential::Replay(bytes, size), "") << size;
+}
+
+
+TEST(Differential, CheckInvariantsOfOtherTrees)
+{
+    Tree::AVLTree<double> doubles;
+    for (int i = 0; i < 500; ++i)
+    {
+        doubles.insert(i * 0.5);
+        ASSERT_TRUE(doubles.check_invariants());
+    }
+    ASSERT_TRUE(Tree::AVLTree<int>().check_invariants());
+}
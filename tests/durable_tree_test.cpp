@@ -0,0 +1,213 @@
+#include "DurableAVLTree.hpp"
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <set>
+#include <string>
+#include <sys/stat.h>
+
+class DurableAVLTree_int : public ::testing::Test
+{
+protected:
+    std::string directory;
+
+    void SetUp() override
+    {
+        directory = ::testing::TempDir() + "durable_" + ::testing::UnitTest::GetInstance()->current_test_info()->name();
+        mkdir(directory.c_str(), 0755);
+        for (const char* name : {"/snapshot", "/log", "/snapshot.tmp", "/log.tmp"})
+            std::remove((directory + name).c_str());
+    }
+
+    std::string file(const char* name) const
+    {
+        std::ifstream in(directory + name, std::ios::binary);
+        return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+
+    void write(const char* name, const std::string& contents) const
+    {
+        std::ofstream out(directory + name, std::ios::binary | std::ios::trunc);
+        out << contents;
+    }
+
+    template<typename Tree_t>
+    static std::set<int> contents(const Tree_t& tree)
+    {
+        return std::set<int>(tree.begin(), tree.end());
+    }
+};
+
+
+TEST_F(DurableAVLTree_int, ReopenRestoresContents)
+{
+    std::set<int> expected;
+    {
+        Tree::DurableAVLTree<int> tree(directory);
+        ASSERT_EQ(tree.size(), 0u);
+        for (int v = 0; v < 500; ++v)
+        {
+            tree.insert(v * 7 % 503);
+            expected.insert(v * 7 % 503);
+        }
+        for (int v = 0; v < 500; v += 3)
+        {
+            ASSERT_EQ(tree.erase(v), expected.erase(v) == 1);
+        }
+        ASSERT_FALSE(tree.insert(7));
+    }
+
+    Tree::DurableAVLTree<int> tree(directory);
+    ASSERT_EQ(contents(tree), expected);
+    ASSERT_EQ(tree.recovered().snapshot_elements, 0u);
+    ASSERT_EQ(tree.recovered().dropped_bytes, 0u);
+}
+
+
+TEST_F(DurableAVLTree_int, GroupCommit)
+{
+    Tree::DurableOptions options;
+    options.batch = 4;
+    options.sync_interval = std::chrono::milliseconds(0);
+    Tree::DurableAVLTree<int> tree(directory, options);
+
+    const std::size_t empty = file("/log").size();
+    tree.insert(1);
+    tree.insert(2);
+    tree.insert(3);
+    ASSERT_EQ(tree.pending(), 3u);
+    ASSERT_EQ(file("/log").size(), empty);
+
+    tree.insert(4);
+    ASSERT_EQ(tree.pending(), 0u);
+    ASSERT_GT(file("/log").size(), empty);
+
+    tree.erase(1);
+    tree.sync();
+    ASSERT_EQ(tree.pending(), 0u);
+}
+
+
+TEST_F(DurableAVLTree_int, TornTailIsDropped)
+{
+    Tree::DurableOptions options;
+    options.batch = 1;
+    {
+        Tree::DurableAVLTree<int> tree(directory, options);
+        for (int v : {3, 1, 4, 1, 5, 9, 2, 6})
+            tree.insert(v);
+        tree.erase(4);
+    }
+
+    // half a record, as left by a crash in the middle of a write
+    std::string log = file("/log");
+    write("/log", log + log.substr(log.size() - 5, 4));
+    {
+        Tree::DurableAVLTree<int> tree(directory, options);
+        ASSERT_EQ(contents(tree), (std::set<int>{1, 2, 3, 5, 6, 9}));
+        ASSERT_EQ(tree.recovered().log_records, 8u);
+        ASSERT_EQ(tree.recovered().dropped_bytes, 4u);
+    }
+
+    // a corrupt record ends the replay: what follows it is not applied
+    Tree::DurableAVLTree<int> reopened(directory, options);
+    ASSERT_EQ(reopened.recovered().snapshot_elements, 6u);
+    ASSERT_EQ(reopened.recovered().log_records, 0u);
+    reopened.insert(10);
+    reopened.insert(11);
+    reopened.sync();
+
+    log = file("/log");
+    log[log.size() - 1] ^= 1;
+    write("/log", log);
+    Tree::DurableAVLTree<int> recovered(directory, options);
+    ASSERT_EQ(contents(recovered), (std::set<int>{1, 2, 3, 5, 6, 9, 10}));
+}
+
+
+TEST_F(DurableAVLTree_int, CheckpointTruncatesLog)
+{
+    Tree::DurableOptions options;
+    options.checkpoint_every = 100;
+    std::set<int> expected;
+    {
+        Tree::DurableAVLTree<int> tree(directory, options);
+        for (int v = 0; v < 250; ++v)
+        {
+            tree.insert(v);
+            expected.insert(v);
+        }
+        ASSERT_LT(file("/log").size(), 100 * (1 + sizeof(int) + 4));
+    }
+
+    Tree::DurableAVLTree<int> tree(directory, options);
+    ASSERT_EQ(contents(tree), expected);
+    ASSERT_EQ(tree.recovered().snapshot_elements, 200u);
+    ASSERT_EQ(tree.recovered().log_records, 50u);
+}
+
+
+TEST_F(DurableAVLTree_int, LogOlderThanSnapshotIsIgnored)
+{
+    Tree::DurableOptions options;
+    options.batch = 1;
+    std::string old_log;
+    {
+        Tree::DurableAVLTree<int> tree(directory, options);
+        tree.insert(1);
+        tree.insert(2);
+        old_log = file("/log");
+        tree.checkpoint();
+        tree.insert(3);
+    }
+
+    // crash after the snapshot rename, before the new log replaced the old one
+    write("/log", old_log);
+    Tree::DurableAVLTree<int> tree(directory, options);
+    ASSERT_EQ(contents(tree), (std::set<int>{1, 2}));
+    ASSERT_EQ(tree.recovered().snapshot_elements, 2u);
+    ASSERT_EQ(tree.recovered().log_records, 0u);
+}
+
+
+TEST_F(DurableAVLTree_int, FailedCheckpointKeepsBufferedRecords)
+{
+    Tree::DurableOptions options;
+    options.batch = 100;
+    options.sync_interval = std::chrono::milliseconds(0);
+    options.checkpoint_every = 0;
+    {
+        Tree::DurableAVLTree<int> tree(directory, options);
+        for (int v : {1, 2, 3})
+            tree.insert(v);
+
+        // a directory in the way: the snapshot cannot be created
+        mkdir((directory + "/snapshot.tmp").c_str(), 0755);
+        ASSERT_THROW(tree.checkpoint(), std::runtime_error);
+        ASSERT_EQ(tree.pending(), 3u);
+
+        std::remove((directory + "/snapshot.tmp").c_str());
+        tree.sync();
+    }
+
+    Tree::DurableAVLTree<int> tree(directory, options);
+    ASSERT_EQ(contents(tree), (std::set<int>{1, 2, 3}));
+}
+
+
+TEST_F(DurableAVLTree_int, CorruptSnapshotCountIsRejected)
+{
+    {
+        Tree::DurableAVLTree<int> tree(directory);
+        for (int v : {1, 2, 3})
+            tree.insert(v);
+        tree.checkpoint();
+    }
+
+    // the high byte of the element count (after magic and generation): checked before anything is allocated
+    std::string snapshot = file("/snapshot");
+    snapshot[4 + 8 + 7] = '\x7f';
+    write("/snapshot", snapshot);
+    ASSERT_THROW(Tree::DurableAVLTree<int> tree(directory), std::runtime_error);
+}
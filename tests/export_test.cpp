@@ -0,0 +1,92 @@
+#include "AVLTree.hpp"
+#include <gtest/gtest.h>
+#include <iterator>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+
+TEST(AVLTreeExport, CopyToAndForEachMatchIteration)
+{
+    Tree::AVLTree<int> tree;
+    std::mt19937 gen(5);
+    for (int i = 0; i < 20000; ++i)
+        tree.insert(static_cast<int>(gen() % 100000));
+
+    std::vector<int> expected(tree.begin(), tree.end());
+
+    std::vector<int> copied;
+    tree.copy_to(std::back_inserter(copied));
+    ASSERT_EQ(copied, expected);
+
+    // raw pointer output: returns the end
+    std::vector<int> buffer(tree.size() + 1, -1);
+    int* end = tree.copy_to(buffer.data());
+    ASSERT_EQ(end - buffer.data(), static_cast<std::ptrdiff_t>(tree.size()));
+    ASSERT_EQ(buffer.back(), -1);
+
+    std::vector<int> visited;
+    tree.for_each([&](int value) { visited.push_back(value); });
+    ASSERT_EQ(visited, expected);
+
+    // same after the breadth-first rebuild
+    tree.compact();
+    copied.clear();
+    tree.copy_to(std::back_inserter(copied));
+    ASSERT_EQ(copied, expected);
+}
+
+
+TEST(AVLTreeExport, ExportRangeBoundsAndContinuation)
+{
+    Tree::AVLTree<int> tree;
+    for (int i = 0; i < 1000; ++i)
+        tree.insert(i * 2);
+
+    int buf[2000];
+    ASSERT_EQ(tree.export_range(10, 20, buf, 2000), 6u);
+    ASSERT_EQ(std::vector<int>(buf, buf + 6), (std::vector<int>{10, 12, 14, 16, 18, 20}));
+
+    // bounds that are not elements
+    ASSERT_EQ(tree.export_range(-5, 3, buf, 2000), 2u);
+    ASSERT_EQ(buf[0], 0);
+    ASSERT_EQ(buf[1], 2);
+    ASSERT_EQ(tree.export_range(1997, 5000, buf, 2000), 1u);
+    ASSERT_EQ(buf[0], 1998);
+
+    // empty ranges
+    ASSERT_EQ(tree.export_range(3, 3, buf, 2000), 0u);
+    ASSERT_EQ(tree.export_range(20, 10, buf, 2000), 0u);
+    ASSERT_EQ(tree.export_range(0, 100, buf, 0), 0u);
+
+    // chunks of 64: continue from just above the last written element
+    std::vector<int> all;
+    int lo = 0;
+    for (;;)
+    {
+        std::size_t written = tree.export_range(lo, 1998, buf, 64);
+        all.insert(all.end(), buf, buf + written);
+        if (written < 64)
+            break;
+        lo = buf[written - 1] + 1;
+    }
+    ASSERT_EQ(all, std::vector<int>(tree.begin(), tree.end()));
+}
+
+
+TEST(AVLTreeExport, EmptyTreeAndStrings)
+{
+    Tree::AVLTree<std::string> tree;
+    std::vector<std::string> out;
+    tree.copy_to(std::back_inserter(out));
+    ASSERT_TRUE(out.empty());
+
+    std::string buf[4];
+    ASSERT_EQ(tree.export_range("a", "z", buf, 4), 0u);
+
+    tree = {"pear", "apple", "fig", "kiwi", "plum"};
+    ASSERT_EQ(tree.export_range("b", "p", buf, 4), 2u);
+    ASSERT_EQ(buf[0], "fig");
+    ASSERT_EQ(buf[1], "kiwi");
+}
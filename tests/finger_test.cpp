@@ -0,0 +1,121 @@
+#include "AVLTree.hpp"
+#include <gtest/gtest.h>
+#include <random>
+#include <set>
+
+
+TEST(AVLTree_finger, SequentialInsertNear)
+{
+    Tree::AVLTree<int> tree;
+    Tree::AVLTree<int>::finger hint;
+    for (int i = 0; i < 5000; ++i)
+    {
+        ASSERT_TRUE(tree.insert_near(hint, i));
+        ASSERT_EQ(hint.get()->data, i);
+    }
+
+    ASSERT_EQ(tree.size(), 5000);
+    ASSERT_EQ(tree.distance(0, 4999), 4999);
+
+    int expected = 0;
+    for (int value : tree)
+        ASSERT_EQ(value, expected++);
+}
+
+
+TEST(AVLTree_finger, DuplicateMovesFinger)
+{
+    Tree::AVLTree<int> tree = {10, 20, 30};
+    Tree::AVLTree<int>::finger hint;
+    ASSERT_FALSE(tree.insert_near(hint, 20));
+    ASSERT_EQ(hint.get()->data, 20);
+    ASSERT_EQ(tree.size(), 3);
+
+    ASSERT_EQ(tree.find_from(hint, 25), nullptr);
+    ASSERT_NE(hint.get(), nullptr);
+    ASSERT_EQ(tree.find_from(hint, 10)->data, 10);
+}
+
+
+TEST(AVLTree_finger, EmptyTree)
+{
+    Tree::AVLTree<int> tree;
+    Tree::AVLTree<int>::finger hint;
+    ASSERT_EQ(tree.find_from(hint, 1), nullptr);
+    ASSERT_EQ(hint.get(), nullptr);
+}
+
+
+TEST(AVLTree_finger, StaleFingerRestartsFromRoot)
+{
+    Tree::AVLTree<int> tree;
+    Tree::AVLTree<int>::finger hint;
+    for (int i = 0; i < 100; ++i)
+        tree.insert_near(hint, i);
+
+    ASSERT_EQ(tree.find_from(hint, 50)->data, 50);
+    tree.erase(50);
+    tree.erase(51);
+    ASSERT_EQ(tree.find_from(hint, 50), nullptr);
+    ASSERT_EQ(tree.find_from(hint, 52)->data, 52);
+
+    tree.clear();
+    ASSERT_EQ(tree.find_from(hint, 52), nullptr);
+
+    Tree::AVLTree<int> other = {1, 2, 3};
+    ASSERT_EQ(other.find_from(hint, 2)->data, 2);
+}
+
+
+TEST(AVLTree_finger, MovedFromTreeRestartsFinger)
+{
+    Tree::AVLTree<int> tree;
+    Tree::AVLTree<int>::finger hint;
+    for (int i = 0; i < 100; ++i)
+        tree.insert_near(hint, i);
+    ASSERT_EQ(tree.find_from(hint, 50)->data, 50);
+
+    // the nodes under the finger now belong to moved, which frees them
+    Tree::AVLTree<int> moved(std::move(tree));
+    moved.clear();
+
+    ASSERT_EQ(tree.find_from(hint, 50), nullptr);
+    ASSERT_TRUE(tree.insert_near(hint, 7));
+    ASSERT_EQ(tree.find_from(hint, 7)->data, 7);
+    ASSERT_EQ(tree.size(), 1);
+}
+
+
+TEST(AVLTree_finger, RandomWalkAgainstStdSet)
+{
+    Tree::AVLTree<int> tree;
+    Tree::AVLTree<int>::finger insert_hint, find_hint;
+    std::set<int> reference;
+    std::mt19937 gen(35);
+
+    int key = 0;
+    for (int step = 0; step < 20000; ++step)
+    {
+        key += static_cast<int>(gen() % 21) - 10;
+        if (gen() % 8 == 0)
+            key = static_cast<int>(gen() % 40000);
+
+        if (gen() % 16 == 0)
+        {
+            ASSERT_EQ(tree.erase(key), reference.erase(key) == 1);
+        }
+        else
+        {
+            ASSERT_EQ(tree.insert_near(insert_hint, key), reference.insert(key).second);
+            ASSERT_EQ(insert_hint.get()->data, key);
+        }
+
+        const auto* node = tree.find_from(find_hint, key + 3);
+        ASSERT_EQ(node != nullptr, reference.count(key + 3) == 1);
+    }
+
+    ASSERT_EQ(tree.size(), reference.size());
+    auto it = reference.begin();
+    for (int value : tree)
+        ASSERT_EQ(value, *it++);
+}
@@ -0,0 +1,83 @@
+#include "HashedAVLTree.hpp"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <iterator>
+#include <random>
+#include <set>
+#include <vector>
+
+class HashedAVLTree_int : public ::testing::Test
+{
+protected:
+    Tree::HashedAVLTree<int> mine, others;
+
+    std::vector<std::pair<int, bool>> diff() const
+    {
+        std::vector<std::pair<int, bool>> result;
+        mine.diff(others, [&result](int v, bool in_mine) { result.emplace_back(v, in_mine); });
+        std::sort(result.begin(), result.end());
+        return result;
+    }
+};
+
+
+TEST_F(HashedAVLTree_int, EqualIgnoresShape)
+{
+    for (int i = 0; i < 1000; ++i) mine.insert(i);
+    for (int i = 999; i >= 0; --i) others.insert(i);
+
+    ASSERT_TRUE(mine.equal(others));
+    ASSERT_EQ(mine.content_hash(), others.content_hash());
+    ASSERT_TRUE(diff().empty());
+
+    others.erase(500);
+    others.insert(1000);
+    ASSERT_FALSE(mine.equal(others));
+    ASSERT_EQ(diff(), (std::vector<std::pair<int, bool>>{{500, true}, {1000, false}}));
+}
+
+
+TEST_F(HashedAVLTree_int, EmptySides)
+{
+    for (int v : {3, 1, 2})
+        mine.insert(v);
+
+    ASSERT_EQ(diff(), (std::vector<std::pair<int, bool>>{{1, true}, {2, true}, {3, true}}));
+    std::swap(mine, others);
+    ASSERT_EQ(diff(), (std::vector<std::pair<int, bool>>{{1, false}, {2, false}, {3, false}}));
+}
+
+
+TEST_F(HashedAVLTree_int, RandomReplicasAgainstStdSet)
+{
+    std::mt19937 gen(32);
+    std::set<int> a, b;
+
+    for (int round = 0; round < 20; ++round)
+    {
+        for (int i = 0; i < 300; ++i)
+        {
+            int v = gen() % 2000;
+            bool both = gen() % 10 != 0;
+            if (gen() % 4 == 0)
+            {
+                if (both || gen() % 2) { a.erase(v); mine.erase(v); }
+                if (both || gen() % 2) { b.erase(v); others.erase(v); }
+            }
+            else
+            {
+                if (both || gen() % 2) { a.insert(v); mine.insert(v); }
+                if (both || gen() % 2) { b.insert(v); others.insert(v); }
+            }
+        }
+
+        std::vector<std::pair<int, bool>> expected;
+        for (int v : a) if (!b.count(v)) expected.emplace_back(v, true);
+        for (int v : b) if (!a.count(v)) expected.emplace_back(v, false);
+        std::sort(expected.begin(), expected.end());
+
+        ASSERT_EQ(expected, diff());
+        ASSERT_EQ(expected.empty(), mine.equal(others));
+        ASSERT_EQ(a == b, mine == others);
+    }
+}
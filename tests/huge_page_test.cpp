@@ -0,0 +1,120 @@
+#include "HugePageStorage.hpp"
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <random>
+#include <set>
+
+
+using HugeTree = Tree::AVLTree<int, unsigned char, Tree::HugePageStorage<>>;
+
+TEST(HugePageStorage, RandomInsertEraseAgainstStdSet)
+{
+    HugeTree tree;
+    std::set<int> reference;
+    std::mt19937 gen(38);
+
+    for (int step = 0; step < 30000; ++step)
+    {
+        int key = static_cast<int>(gen() % 5000);
+        if (gen() % 3 == 0)
+            ASSERT_EQ(tree.erase(key), reference.erase(key) == 1);
+        else
+            ASSERT_EQ(tree.insert(key), reference.insert(key).second);
+    }
+
+    ASSERT_EQ(tree.size(), reference.size());
+    auto it = reference.begin();
+    for (int value : tree)
+        ASSERT_EQ(value, *it++);
+}
+
+
+TEST(HugePageStorage, NodesComeFromSlabs)
+{
+    std::size_t before = Tree::HugePageStorage<>::stats().blocks;
+    {
+        HugeTree tree;
+        for (int i = 0; i < 1000; ++i)
+            tree.insert(i);
+
+        Tree::HugePageArena::Stats stats = Tree::HugePageStorage<>::stats();
+        ASSERT_EQ(stats.blocks, before + 1000);
+        ASSERT_GE(stats.slabs, 1u);
+
+        HugeTree copy(tree);
+        ASSERT_TRUE(copy == tree);
+        ASSERT_EQ(Tree::HugePageStorage<>::stats().blocks, before + 2000);
+    }
+    ASSERT_EQ(Tree::HugePageStorage<>::stats().blocks, before);
+}
+
+
+struct WideKey
+{
+    int key;
+    char payload[256];
+
+    WideKey(int key) : key(key), payload() { }
+    bool operator<(const WideKey& other) const { return key < other.key; }
+    bool operator>(const WideKey& other) const { return key > other.key; }
+    bool operator==(const WideKey& other) const { return key == other.key; }
+    bool operator!=(const WideKey& other) const { return key != other.key; }
+};
+
+TEST(HugePageStorage, ChildOnParentSlab)
+{
+    Tree::AVLTree<WideKey, unsigned char, Tree::HugePageStorage<>> tree;
+    const int count = 10000; // ~290 bytes a node: two slabs
+    for (int i = 0; i < count; ++i)
+        tree.insert(WideKey(i * 2));
+
+    // holes in the first slab: allocations without a hint would go there
+    for (int i = 0; i < 2000; ++i)
+        tree.erase(WideKey(i * 2));
+
+    const auto slab = [](const void* node) { return reinterpret_cast<std::uintptr_t>(node) / Tree::HugePageArena::slab_bytes; };
+    for (int i = count - 50; i < count - 1; ++i)
+    {
+        tree.insert(WideKey(i * 2 + 1));
+        std::uintptr_t own = slab(tree.find(WideKey(i * 2 + 1)));
+        ASSERT_TRUE(own == slab(tree.find(WideKey(i * 2))) || own == slab(tree.find(WideKey(i * 2 + 2)))) << i;
+    }
+}
+
+
+// subtree sum: the base augment still gets its update() calls
+struct SumAugment : Tree::NoAugment
+{
+    long long sum = 0;
+
+    template<typename Node>
+    static void update(Node* root)
+    {
+        root->sum = root->data;
+    }
+};
+
+TEST(HugePageStorage, WrapsAnotherAugment)
+{
+    Tree::AVLTree<int, unsigned char, Tree::HugePageStorage<SumAugment>> tree;
+    for (int i = 1; i <= 100; ++i)
+        tree.insert(i);
+
+    for (int i = 1; i <= 100; ++i)
+        ASSERT_EQ(tree.find(i)->sum, i);
+}
+
+
+TEST(HugePageStorage, InsertAfterCompact)
+{
+    // parents in a compact() block are not in any slab: their placement hint must be ignored
+    Tree::AVLTree<int, unsigned char, Tree::HugePageStorage<>> tree;
+    for (int i = 0; i < 32500; ++i)
+        ASSERT_TRUE(tree.insert(i * 2));
+    tree.compact();
+
+    for (int i = 0; i < 32500; ++i)
+        ASSERT_TRUE(tree.insert(i * 2 + 1));
+    ASSERT_EQ(tree.size(), 65000u);
+    ASSERT_TRUE(tree.check_invariants());
+}
@@ -0,0 +1,122 @@
+#include "AVLTree.hpp"
+#include "CountAllocations.hpp"
+#include "Reclaimer.hpp"
+#include <gtest/gtest.h>
+#include <random>
+#include <string>
+#include <vector>
+
+
+TEST(AVLTreeIncrementalClear, ClearStepFreesAtMostBudget)
+{
+    CountedTree tree;
+    std::mt19937 gen(48);
+    for (int i = 0; i < 10000; ++i)
+        tree.insert(static_cast<int>(gen() % 50000));
+    const long live = CountAllocations::live();
+    const long size = tree.size();
+
+    // empty after the first call, whatever the budget
+    ASSERT_FALSE(tree.clear_step(0));
+    ASSERT_EQ(tree.size(), 0u);
+    ASSERT_EQ(tree.begin(), tree.end());
+    ASSERT_EQ(CountAllocations::live(), live);
+
+    int steps = 0;
+    long before = CountAllocations::live();
+    while (!tree.clear_step(100))
+    {
+        ASSERT_LE(before - CountAllocations::live(), 100);
+        before = CountAllocations::live();
+        ++steps;
+
+        // the tree is usable between the steps, new elements are not part of the pass
+        if (steps == 5)
+        {
+            ASSERT_TRUE(tree.insert(7));
+            ASSERT_TRUE(tree.insert(3));
+        }
+    }
+    ASSERT_GT(steps, 10000 / 100);
+    ASSERT_EQ(CountAllocations::live(), live - size + 2);
+    ASSERT_EQ(tree.size(), 2u);
+    ASSERT_TRUE(tree.check_invariants());
+
+    // nothing pending, a new pass takes the two new elements
+    ASSERT_TRUE(tree.clear_step(10));
+    ASSERT_EQ(CountAllocations::live(), live - size);
+}
+
+
+TEST(AVLTreeIncrementalClear, DetachLeavesAnEmptyTree)
+{
+    CountedTree tree;
+    for (int i = 0; i < 3000; ++i)
+        tree.insert(i);
+    tree.compact();
+    const long live = CountAllocations::live();
+
+    CountedTree detached = tree.detach();
+    ASSERT_EQ(tree.size(), 0u);
+    ASSERT_EQ(detached.size(), 3000u);
+    ASSERT_EQ(CountAllocations::live(), live);
+
+    // the emptied tree is independent of the detached nodes (and of their compact() blocks)
+    for (int i = 0; i < 100; ++i)
+        tree.insert(-i);
+    ASSERT_TRUE(tree.check_invariants());
+    ASSERT_TRUE(detached.check_invariants());
+
+    while (!detached.clear_step(64))
+    {
+    }
+    ASSERT_EQ(detached.size(), 0u);
+    ASSERT_EQ(tree.size(), 100u);
+}
+
+
+TEST(AVLTreeIncrementalClear, PendingNodesFollowMovesAndDestruction)
+{
+    const long live = CountAllocations::live();
+    {
+        CountedTree tree;
+        tree.reuse_nodes();
+        for (int i = 0; i < 500; ++i)
+            tree.insert(i);
+        tree.clear_step(10);
+
+        CountedTree moved(std::move(tree));
+        CountedTree other;
+        other.insert(1);
+        other.swap(moved);
+        moved = std::move(other);
+        ASSERT_EQ(moved.size(), 0u);
+        ASSERT_GT(moved.capacity(), 0u);
+    }
+    ASSERT_EQ(CountAllocations::live(), live);
+}
+
+
+TEST(AVLTreeIncrementalClear, ReclaimerFreesOnItsThread)
+{
+    const long live = CountAllocations::live();
+    {
+        Tree::Reclaimer reclaimer(256);
+        for (int round = 0; round < 4; ++round)
+        {
+            CountedTree tree;
+            for (int i = 0; i < 5000; ++i)
+                tree.insert(i * 7 % 5003);
+            reclaimer.retire(tree.detach());
+            ASSERT_EQ(tree.size(), 0u);
+        }
+        reclaimer.drain();
+        ASSERT_EQ(reclaimer.pending(), 0u);
+        ASSERT_EQ(CountAllocations::live(), live);
+
+        // still queued at destruction: freed before the join
+        Tree::AVLTree<std::string> strings = {"a", "b", "c"};
+        reclaimer.retire(strings.detach());
+    }
+    ASSERT_EQ(CountAllocations::live(), live);
+}
@@ -0,0 +1,89 @@
+#include "IntervalTree.hpp"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using Interval = std::pair<double, double>;
+
+class IntervalTree_double : public ::testing::Test
+{
+protected:
+    Tree::IntervalTree<double> obj;
+    std::vector<Interval> expected;
+
+    std::vector<Interval> brute(double lo, double hi) const
+    {
+        std::vector<Interval> result;
+        for (const Interval& v : expected)
+            if (!(v.second < lo) && !(hi < v.first))
+                result.push_back(v);
+        std::sort(result.begin(), result.end());
+        return result;
+    }
+
+    std::vector<Interval> query(double lo, double hi) const
+    {
+        std::vector<Interval> result;
+        obj.overlapping(Interval(lo, hi), [&result](const Interval& v) { result.push_back(v); });
+        std::sort(result.begin(), result.end());
+        return result;
+    }
+};
+
+
+TEST_F(IntervalTree_double, PointQuery)
+{
+    Interval values[] = {{1.0, 5.0}, {2.0, 3.0}, {4.0, 8.0}, {6.0, 7.0}, {9.0, 10.0}};
+    for (const Interval& v : values)
+        obj.insert(v);
+
+    std::vector<Interval> result;
+    obj.overlapping(4.5, [&result](const Interval& v) { result.push_back(v); });
+    std::sort(result.begin(), result.end());
+
+    ASSERT_EQ(result, (std::vector<Interval>{{1.0, 5.0}, {4.0, 8.0}}));
+    ASSERT_EQ(obj.count_overlapping(4.5), 2);
+    ASSERT_EQ(obj.count_overlapping(8.5), 0);
+    ASSERT_EQ(obj.count_overlapping(10.0), 1);
+}
+
+
+TEST_F(IntervalTree_double, EmptyTree)
+{
+    ASSERT_EQ(obj.count_overlapping(1.0), 0);
+    ASSERT_EQ(obj.count_overlapping(Interval(0.0, 100.0)), 0);
+}
+
+
+TEST_F(IntervalTree_double, RandomInsertEraseAgainstBruteForce)
+{
+    std::mt19937 gen(26);
+    std::uniform_int_distribution<int> start(0, 1000), length(0, 50);
+
+    for (int i = 0; i < 2000; ++i)
+    {
+        double lo = start(gen);
+        Interval v(lo, lo + length(gen));
+
+        if (i % 3 == 2 && !expected.empty())
+        {
+            Interval victim = expected[gen() % expected.size()];
+            ASSERT_TRUE(obj.erase(victim));
+            expected.erase(std::find(expected.begin(), expected.end(), victim));
+        }
+        else if (obj.insert(v))
+            expected.push_back(v);
+
+        if (i % 50 == 0)
+        {
+            double qlo = start(gen), qhi = qlo + length(gen);
+            ASSERT_EQ(brute(qlo, qhi), query(qlo, qhi));
+            ASSERT_EQ(brute(qlo, qlo).size(), obj.count_overlapping(qlo));
+        }
+    }
+
+    Tree::IntervalTree<double> copy = obj;
+    ASSERT_EQ(brute(100.0, 300.0), query(100.0, 300.0));
+    ASSERT_EQ(brute(100.0, 300.0).size(), copy.count_overlapping(Interval(100.0, 300.0)));
+}
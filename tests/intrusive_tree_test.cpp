@@ -0,0 +1,114 @@
+#include "IntrusiveAVLTree.hpp"
+#include <gtest/gtest.h>
+#include <cstdlib>
+#include <new>
+#include <random>
+#include <set>
+#include <vector>
+
+// every heap allocation of this binary is counted
+static std::size_t allocations = 0;
+
+void* operator new(std::size_t size)
+{
+    ++allocations;
+    if (void* ptr = std::malloc(size ? size : 1))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+struct Order : Tree::AVLHook<Order>
+{
+    int id = 0;
+    double price = 0;
+
+    bool operator<(const Order& other) const { return id < other.id; }
+    bool operator>(const Order& other) const { return id > other.id; }
+    bool operator==(const Order& other) const { return id == other.id; }
+    bool operator!=(const Order& other) const { return id != other.id; }
+};
+
+class IntrusiveAVLTree_order : public ::testing::Test
+{
+protected:
+    std::vector<Order> pool = std::vector<Order>(1000);
+    Tree::IntrusiveAVLTree<Order> obj;
+
+    void SetUp() override
+    {
+        for (std::size_t i = 0; i < pool.size(); ++i)
+            pool[i].id = static_cast<int>(i);
+    }
+
+    std::vector<int> ids() const
+    {
+        std::vector<int> result;
+        obj.for_each([&result](const Order& order) { result.push_back(order.id); });
+        return result;
+    }
+};
+
+
+TEST_F(IntrusiveAVLTree_order, LinkUnlinkWithoutAllocation)
+{
+    std::size_t before = allocations;
+
+    for (Order& order : pool)
+        ASSERT_TRUE(obj.insert(order));
+    ASSERT_FALSE(obj.insert(pool[10]));
+    ASSERT_EQ(obj.size(), 1000);
+
+    ASSERT_EQ(obj.find(pool[500]), &pool[500]);
+    ASSERT_EQ(obj.rank(pool[500]), 500);
+    ASSERT_EQ(obj.erase(pool[500]), &pool[500]);
+    ASSERT_EQ(obj.erase(pool[500]), nullptr);
+    ASSERT_EQ(obj.find(pool[500]), nullptr);
+    ASSERT_EQ(obj.rank(pool[501]), 500);
+
+    ASSERT_EQ(before, allocations);
+}
+
+
+TEST_F(IntrusiveAVLTree_order, CopyIsNotLinked)
+{
+    obj.insert(pool[1]);
+    obj.insert(pool[2]);
+
+    Order copy = pool[1];
+    copy.id = 3;
+    ASSERT_TRUE(obj.insert(copy));
+    ASSERT_EQ(ids(), (std::vector<int>{1, 2, 3}));
+}
+
+
+TEST_F(IntrusiveAVLTree_order, RandomAgainstStdSet)
+{
+    std::set<int> expected;
+    std::mt19937 gen(29);
+
+    for (int i = 0; i < 20000; ++i)
+    {
+        Order& order = pool[gen() % pool.size()];
+        if (gen() % 3 == 0)
+            ASSERT_EQ(expected.erase(order.id) == 1, obj.erase(order) == &order);
+        else
+            ASSERT_EQ(expected.insert(order.id).second, obj.insert(order));
+    }
+
+    ASSERT_EQ(expected.size(), obj.size());
+    ASSERT_EQ(std::vector<int>(expected.begin(), expected.end()), ids());
+
+    Tree::IntrusiveAVLTree<Order> moved = std::move(obj);
+    ASSERT_EQ(0, obj.size());
+    ASSERT_EQ(expected.size(), moved.size());
+}
@@ -0,0 +1,122 @@
+#include "LeftRightAVLTree.hpp"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+
+TEST(LeftRightAVLTree, SingleThread)
+{
+    Tree::LeftRightAVLTree<int> tree;
+    auto& reader = tree.reader();
+
+    ASSERT_TRUE(tree.insert(5));
+    ASSERT_FALSE(tree.insert(5));
+    ASSERT_TRUE(tree.insert(7));
+    ASSERT_TRUE(tree.contains(reader, 5));
+    ASSERT_FALSE(tree.contains(reader, 6));
+    ASSERT_EQ(tree.size(), 2);
+
+    ASSERT_TRUE(tree.erase(5));
+    ASSERT_FALSE(tree.erase(5));
+    ASSERT_FALSE(tree.contains(reader, 5));
+
+    Tree::AVLTree<int> contents = {1, 2, 3};
+    tree.assign(contents);
+    ASSERT_EQ(tree.read(reader, [](const Tree::AVLTree<int>& current) { return current == Tree::AVLTree<int>({1, 2, 3}); }), true);
+    ASSERT_EQ(tree.size(), 3);
+}
+
+
+TEST(LeftRightAVLTree, InitialContents)
+{
+    Tree::LeftRightAVLTree<int> tree(Tree::AVLTree<int>({4, 8}));
+    auto& reader = tree.reader();
+    ASSERT_TRUE(tree.contains(reader, 4));
+    ASSERT_TRUE(tree.insert(6));
+    ASSERT_EQ(tree.read(reader, [](const Tree::AVLTree<int>& current) { return current.distance(4, 8); }), 2u);
+}
+
+
+// writes come in pairs (k, -k) in one write(): a reader must never see half of a pair
+TEST(LeftRightAVLTree, ReadersSeeWholeWrites)
+{
+    Tree::LeftRightAVLTree<int> tree;
+    std::atomic<bool> done(false);
+    std::atomic<int> torn(0);
+
+    std::vector<std::thread> threads;
+    for (int r = 0; r < 4; ++r)
+    {
+        auto& reader = tree.reader();
+        threads.emplace_back([&tree, &reader, &done, &torn]() {
+            while (!done.load())
+            {
+                bool whole = tree.read(reader, [](const Tree::AVLTree<int>& current) {
+                    if (current.size() % 2 != 0)
+                        return false;
+                    for (int value : current)
+                    {
+                        if (current.find(-value) == nullptr)
+                            return false;
+                    }
+                    return true;
+                });
+                torn += !whole;
+            }
+        });
+    }
+
+    for (int k = 1; k <= 300; ++k)
+    {
+        tree.write([k](Tree::AVLTree<int>& current) {
+            current.insert(k);
+            current.insert(-k);
+        });
+
+        if (k % 3 == 0)
+        {
+            tree.write([k](Tree::AVLTree<int>& current) {
+                current.erase(k - 1);
+                current.erase(1 - k);
+            });
+        }
+    }
+
+    done = true;
+    for (std::thread& thread : threads)
+        thread.join();
+
+    ASSERT_EQ(torn.load(), 0);
+    ASSERT_EQ(tree.size(), 400);
+}
+
+
+// distance() keeps no state in the tree: readers may call it on the same copy at once
+TEST(LeftRightAVLTree, ConcurrentDistance)
+{
+    Tree::AVLTree<int> contents;
+    for (int i = 0; i < 1000; ++i)
+        contents.insert(i * 2);
+    Tree::LeftRightAVLTree<int> tree(std::move(contents));
+    std::atomic<int> wrong(0);
+
+    std::vector<std::thread> threads;
+    for (int r = 0; r < 4; ++r)
+    {
+        auto& reader = tree.reader();
+        threads.emplace_back([&tree, &reader, &wrong, r]() {
+            for (int i = 0; i < 2000; ++i)
+            {
+                int lo = (i * 7 + r) % 500 * 2, hi = lo + 2 * (1 + i % 400);
+                unsigned int distance = tree.read(reader, [lo, hi](const Tree::AVLTree<int>& current) { return current.distance(lo, hi); });
+                wrong += distance != static_cast<unsigned int>((hi - lo) / 2);
+            }
+        });
+    }
+
+    for (std::thread& thread : threads)
+        thread.join();
+
+    ASSERT_EQ(wrong.load(), 0);
+}
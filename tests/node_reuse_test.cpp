@@ -0,0 +1,144 @@
+#include "AVLTree.hpp"
+#include "CountAllocations.hpp"
+#include "HashedAVLTree.hpp"
+#include <gtest/gtest.h>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+
+TEST(AVLTreeNodeReuse, RebuildCyclesDoNotAllocate)
+{
+    CountedTree tree;
+    tree.reserve(5000);
+    ASSERT_EQ(tree.capacity(), 5000u);
+    ASSERT_EQ(tree.size(), 0u);
+
+    const std::size_t allocated = CountAllocations::allocations();
+    std::mt19937 gen(47);
+    for (int session = 0; session < 5; ++session)
+    {
+        for (int i = 0; i < 5000; ++i)
+            tree.insert(static_cast<int>(gen() % 20000));
+        for (int i = 0; i < 1000; ++i)
+            tree.erase(static_cast<int>(gen() % 20000));
+        ASSERT_TRUE(tree.check_invariants());
+
+        tree.clear();
+        ASSERT_EQ(tree.size(), 0u);
+        ASSERT_EQ(tree.capacity(), 5000u);
+    }
+    ASSERT_EQ(CountAllocations::allocations(), allocated);
+
+    const std::size_t freed = CountAllocations::frees();
+    tree.shrink_to_fit();
+    ASSERT_EQ(tree.capacity(), 0u);
+    ASSERT_EQ(CountAllocations::frees() - freed, 5000u);
+}
+
+
+TEST(AVLTreeNodeReuse, ReusedNodesBehaveLikeNewOnes)
+{
+    Tree::AVLTree<std::string> tree;
+    tree.reuse_nodes();
+    std::set<std::string> expected;
+    std::mt19937 gen(3);
+
+    for (int step = 0; step < 5000; ++step)
+    {
+        std::string key = std::to_string(gen() % 500);
+        if (gen() % 3 == 0)
+            ASSERT_EQ(tree.erase(key), expected.erase(key) == 1);
+        else
+            ASSERT_EQ(tree.insert(key), expected.insert(key).second);
+    }
+    ASSERT_TRUE(tree.check_invariants());
+    ASSERT_TRUE(std::equal(expected.begin(), expected.end(), tree.begin()));
+    ASSERT_GE(tree.capacity(), tree.size());
+
+    // copy assignment and the sorted merge take spare nodes too
+    Tree::AVLTree<std::string> other = { "a", "b", "c" };
+    tree = other;
+    ASSERT_TRUE(tree == other);
+    ASSERT_GT(tree.capacity(), tree.size());
+
+    tree.reuse_nodes(false);
+    ASSERT_EQ(tree.capacity(), tree.size());
+}
+
+
+TEST(AVLTreeNodeReuse, MoveSwapAndCompact)
+{
+    CountedTree tree;
+    tree.reserve(100);
+    for (int i = 0; i < 50; ++i)
+        tree.insert(i);
+    tree.compact();
+    for (int i = 0; i < 50; i += 2)
+        tree.erase(i);
+    ASSERT_EQ(tree.capacity(), 100u);
+
+    CountedTree moved(std::move(tree));
+    ASSERT_EQ(moved.capacity(), 100u);
+    ASSERT_EQ(tree.capacity(), 0u);
+
+    CountedTree other;
+    other.swap(moved);
+    ASSERT_EQ(other.capacity(), 100u);
+    ASSERT_EQ(moved.capacity(), 0u);
+
+    moved = std::move(other);
+    ASSERT_EQ(moved.size(), 25u);
+    ASSERT_EQ(moved.capacity(), 100u);
+    ASSERT_TRUE(moved.check_invariants());
+
+    // every node of a destroyed tree is freed, spares included
+    const std::size_t allocations = CountAllocations::allocations(), frees = CountAllocations::frees();
+    {
+        CountedTree scoped;
+        scoped.reserve(10);
+        scoped.insert(1);
+        scoped.insert(2);
+        scoped.clear();
+    }
+    ASSERT_EQ(CountAllocations::allocations() - allocations, CountAllocations::frees() - frees);
+}
+
+
+TEST(AVLTreeNodeReuse, ReusedNodesDropOldAugmentation)
+{
+    // a hashed node caches the hash of its own element: a reused node must not keep the old one
+    Tree::HashedAVLTree<int> reused, fresh;
+    reused.reuse_nodes();
+    for (int i = 0; i < 10; ++i)
+        reused.insert(i);
+    reused.clear();
+
+    for (int i = 100; i < 110; ++i)
+    {
+        reused.insert(i);
+        fresh.insert(i);
+    }
+    ASSERT_EQ(reused.content_hash(), fresh.content_hash());
+    ASSERT_TRUE(reused.equal(fresh));
+}
+
+
+TEST(AVLTreeNodeReuse, ReserveDuringCompactStep)
+{
+    CountedTree tree;
+    for (int i = 0; i < 2000; ++i)
+        tree.insert(i);
+    tree.compact_step(10);
+
+    tree.reserve(3000);
+    ASSERT_EQ(tree.capacity(), 3000u);
+
+    while (!tree.compact_step(100));
+    for (int i = 2000; i < 3000; ++i)
+        tree.insert(i);
+    ASSERT_EQ(tree.size(), 3000u);
+    ASSERT_EQ(tree.capacity(), 3000u);
+    ASSERT_TRUE(tree.check_invariants());
+}
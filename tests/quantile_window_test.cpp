@@ -0,0 +1,113 @@
+#include "QuantileWindow.hpp"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <deque>
+#include <random>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+
+TEST(QuantileWindow, MatchesSortedWindow)
+{
+    Tree::QuantileWindow<int> window(500);
+    std::deque<int> expected;
+    std::mt19937 gen(49);
+
+    for (int step = 0; step < 5000; ++step)
+    {
+        // narrow range: many equal samples
+        int sample = static_cast<int>(gen() % 100);
+        window.push(sample);
+        expected.push_back(sample);
+        if (expected.size() > 500)
+            expected.pop_front();
+
+        if (step % 97 == 0)
+        {
+            std::vector<int> sorted(expected.begin(), expected.end());
+            std::sort(sorted.begin(), sorted.end());
+            ASSERT_EQ(window.size(), sorted.size());
+            for (double q : {0.0, 0.5, 0.9, 0.99, 1.0})
+                ASSERT_EQ(window.quantile(q), sorted[static_cast<std::size_t>(q * (sorted.size() - 1))]) << q;
+            for (std::size_t i = 0; i < sorted.size(); i += 37)
+                ASSERT_EQ(window.select(i), sorted[i]);
+
+            const std::ptrdiff_t k = std::min<std::ptrdiff_t>(10, sorted.size());
+            std::vector<int> top, bottom;
+            window.top_k(10, top);
+            window.bottom_k(10, bottom);
+            ASSERT_EQ(top, std::vector<int>(sorted.rbegin(), sorted.rbegin() + k));
+            ASSERT_EQ(bottom, std::vector<int>(sorted.begin(), sorted.begin() + k));
+        }
+    }
+}
+
+
+TEST(QuantileWindow, ExpireAndSmallWindows)
+{
+    Tree::QuantileWindow<double> window(4);
+    ASSERT_TRUE(window.empty());
+    ASSERT_THROW(window.quantile(0.5), std::out_of_range);
+
+    for (double sample : {5.0, 1.0, 5.0, 3.0})
+        window.push(sample);
+    ASSERT_EQ(window.quantile(0.5), 3.0);
+    ASSERT_EQ(window.quantile(1.0), 5.0);
+
+    // full: the oldest 5.0 goes
+    window.push(2.0);
+    ASSERT_EQ(window.size(), 4u);
+    std::vector<double> all;
+    window.bottom_k(10, all);
+    ASSERT_EQ(all, (std::vector<double>{1.0, 2.0, 3.0, 5.0}));
+
+    window.expire(2);
+    window.top_k(10, all);
+    ASSERT_EQ(all, (std::vector<double>{3.0, 2.0}));
+    ASSERT_THROW(window.select(2), std::out_of_range);
+
+    window.expire(10);
+    ASSERT_TRUE(window.empty());
+    window.push(7.0);
+    ASSERT_EQ(window.quantile(0.0), 7.0);
+
+    window.clear();
+    ASSERT_TRUE(window.empty());
+    window.top_k(3, all);
+    ASSERT_TRUE(all.empty());
+
+    ASSERT_THROW(Tree::QuantileWindow<int>(0), std::invalid_argument);
+    ASSERT_THROW(Tree::QuantileWindow<int>(70000), std::invalid_argument);
+}
+
+
+// top_k / bottom_k are const and share no buffer: readers run in parallel on one window
+TEST(QuantileWindow, ConcurrentReaders)
+{
+    Tree::QuantileWindow<int> window(1000);
+    for (int i = 0; i < 1000; ++i)
+        window.push(i);
+
+    std::vector<std::thread> readers;
+    std::vector<bool> ok(4, true);
+    for (std::size_t r = 0; r < ok.size(); ++r)
+    {
+        readers.emplace_back([&window, &ok, r]() {
+            std::vector<int> out;
+            for (std::size_t k = 1; k < 200; ++k)
+            {
+                window.top_k(k, out);
+                bool top = out.size() == k && out.front() == 999 && out.back() == static_cast<int>(1000 - k);
+                window.bottom_k(k, out);
+                bool bottom = out.size() == k && out.front() == 0 && out.back() == static_cast<int>(k - 1);
+                if (!top || !bottom)
+                    ok[r] = false;
+            }
+        });
+    }
+
+    for (std::thread& reader : readers)
+        reader.join();
+    ASSERT_EQ(ok, std::vector<bool>(ok.size(), true));
+}
@@ -0,0 +1,127 @@
+#include "AVLTree.hpp"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <numeric>
+#include <random>
+#include <thread>
+#include <vector>
+#if ((defined(_MSVC_LANG) && _MSVC_LANG >= 202002L) || __cplusplus >= 202002L)
+#include <ranges>
+
+static_assert(std::bidirectional_iterator<Tree::AVLTree<int>::cursor>);
+static_assert(std::ranges::bidirectional_range<Tree::AVLTree<int>::range_type>);
+static_assert(std::ranges::sized_range<Tree::AVLTree<int>::range_type>);
+static_assert(std::ranges::bidirectional_range<Tree::AVLTree<int>::reverse_range_type>);
+static_assert(std::ranges::sized_range<Tree::AVLTree<int>::reverse_range_type>);
+#endif
+
+class AVLTree_range : public ::testing::Test
+{
+protected:
+    Tree::AVLTree<int> obj;
+
+    void SetUp() override
+    {
+        for (int i = 0; i < 100; ++i)
+            obj.insert(i * 2); // 0, 2, ..., 198
+    }
+};
+
+
+TEST_F(AVLTree_range, CursorWalksBothWays)
+{
+    std::vector<int> forward(obj.cursor_begin(), obj.cursor_end());
+    std::vector<int> expected(obj.begin(), obj.end());
+    ASSERT_EQ(expected, forward);
+
+    std::vector<int> backward;
+    for (auto it = obj.cursor_end(); it != obj.cursor_begin();)
+        backward.push_back(*--it);
+    ASSERT_EQ(std::vector<int>(expected.rbegin(), expected.rend()), backward);
+}
+
+
+// The cursor keeps its path from root: random steps both ways, from a cursor built mid-tree
+TEST_F(AVLTree_range, CursorRandomSteps)
+{
+    std::vector<int> expected(obj.begin(), obj.end());
+    Tree::AVLTree<int>::cursor it = obj.range(101, 1000).begin();
+    std::size_t index = 51;
+    std::mt19937 gen(33);
+
+    for (int i = 0; i < 10000; ++i)
+    {
+        if (index == expected.size() || (index != 0 && gen() % 2 == 0))
+        {
+            --it;
+            --index;
+        }
+        else
+        {
+            ++it;
+            ++index;
+        }
+
+        if (index == expected.size())
+        {
+            ASSERT_EQ(it, obj.cursor_end());
+        }
+        else
+        {
+            ASSERT_EQ(expected[index], *it);
+        }
+    }
+}
+
+
+TEST_F(AVLTree_range, RangeBoundsAndSize)
+{
+    Tree::AVLTree<int>::range_type r = obj.range(9, 20);
+    ASSERT_EQ(r.size(), 6);
+    ASSERT_EQ(std::vector<int>(r.begin(), r.end()), (std::vector<int>{10, 12, 14, 16, 18, 20}));
+
+    Tree::AVLTree<int>::reverse_range_type rr = obj.reverse_range(9, 20);
+    ASSERT_EQ(rr.size(), 6);
+    ASSERT_EQ(std::vector<int>(rr.begin(), rr.end()), (std::vector<int>{20, 18, 16, 14, 12, 10}));
+
+    ASSERT_TRUE(obj.range(11, 11).empty());
+    ASSERT_TRUE(obj.range(20, 10).empty());
+    ASSERT_EQ(obj.range(190, 1000).size(), 5);
+    ASSERT_EQ(std::vector<int>(obj.reverse_range(-5, 2).begin(), obj.reverse_range(-5, 2).end()), (std::vector<int>{2, 0}));
+    ASSERT_TRUE(Tree::AVLTree<int>().range(0, 10).empty());
+}
+
+
+TEST_F(AVLTree_range, SplitRangeCoversTreeOnce)
+{
+    for (std::size_t parts : {1u, 3u, 7u, 100u, 1000u})
+    {
+        std::vector<Tree::AVLTree<int>::range_type> ranges = obj.split_range(parts);
+        std::vector<int> joined;
+        for (const auto& r : ranges)
+        {
+            std::vector<int> piece(r.begin(), r.end());
+            ASSERT_EQ(piece.size(), r.size());
+            joined.insert(joined.end(), piece.begin(), piece.end());
+        }
+        ASSERT_EQ(std::vector<int>(obj.begin(), obj.end()), joined);
+    }
+
+    std::vector<Tree::AVLTree<int>::range_type> ranges = obj.split_range(10, 29, 3);
+    ASSERT_EQ(ranges.size(), 3);
+    ASSERT_EQ(ranges[0].size() + ranges[1].size() + ranges[2].size(), 10);
+    ASSERT_TRUE(Tree::AVLTree<int>().split_range(4).empty());
+}
+
+
+TEST_F(AVLTree_range, ParallelScanOverSplitRanges)
+{
+    std::atomic<long long> sum(0);
+    std::vector<std::thread> threads;
+    for (const auto& r : obj.split_range(4))
+        threads.emplace_back([&sum, r]() { sum += std::accumulate(r.begin(), r.end(), 0LL); });
+    for (std::thread& thread : threads)
+        thread.join();
+
+    ASSERT_EQ(sum.load(), 99LL * 100);
+}
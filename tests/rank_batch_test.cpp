@@ -0,0 +1,80 @@
+#include "AVLTree.hpp"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+
+TEST(AVLTreeRankBatch, MatchesRankOfEveryKey)
+{
+    Tree::AVLTree<int> tree;
+    for (int i = 0; i < 1000; ++i)
+        tree.insert(i * 3);
+
+    // present, missing, duplicated, out of range
+    std::vector<int> keys = {-10, 0, 0, 1, 2, 3, 299, 300, 300, 301, 1500, 2997, 2998, 5000};
+    std::vector<std::size_t> out;
+    tree.rank_batch(keys, out);
+
+    ASSERT_EQ(out.size(), keys.size());
+    for (std::size_t i = 0; i < keys.size(); ++i)
+        ASSERT_EQ(out[i], static_cast<std::size_t>(std::count_if(tree.begin(), tree.end(), [&](int v) { return v < keys[i]; }))) << keys[i];
+
+    // unsorted input: same answers
+    std::vector<int> shuffled = keys;
+    std::shuffle(shuffled.begin(), shuffled.end(), std::mt19937(42));
+    std::vector<std::size_t> unsorted;
+    tree.rank_batch(shuffled, unsorted);
+    for (std::size_t i = 0; i < shuffled.size(); ++i)
+        ASSERT_EQ(unsorted[i], out[std::find(keys.begin(), keys.end(), shuffled[i]) - keys.begin()]);
+}
+
+
+TEST(AVLTreeRankBatch, EmptyTreeAndEmptyBatch)
+{
+    Tree::AVLTree<int> tree;
+    std::vector<std::size_t> out(3, 7);
+    tree.rank_batch({1, 2, 3}, out);
+    ASSERT_EQ(out, (std::vector<std::size_t>{0, 0, 0}));
+
+    tree.insert(1);
+    tree.rank_batch({}, out);
+    ASSERT_TRUE(out.empty());
+}
+
+
+TEST(AVLTreeRankBatch, DistanceBatchMatchesDistance)
+{
+    Tree::AVLTree<int> tree;
+    std::mt19937 gen(42);
+    for (int i = 0; i < 3000; ++i)
+        tree.insert(static_cast<int>(gen() % 10000));
+
+    std::vector<std::pair<int, int>> pairs;
+    for (int i = 0; i < 2000; ++i)
+        pairs.emplace_back(static_cast<int>(gen() % 10000), static_cast<int>(gen() % 10000));
+    pairs.emplace_back(*tree.begin(), *tree.rbegin());
+    pairs.emplace_back(*tree.begin(), *tree.begin());
+
+    std::vector<unsigned int> out;
+    tree.distance_batch(pairs, out);
+    ASSERT_EQ(out.size(), pairs.size());
+    for (std::size_t i = 0; i < pairs.size(); ++i)
+        ASSERT_EQ(out[i], tree.distance(pairs[i].first, pairs[i].second)) << pairs[i].first << " " << pairs[i].second;
+    ASSERT_EQ(out[pairs.size() - 2], tree.size() - 1u);
+}
+
+
+TEST(AVLTreeRankBatch, StringKeys)
+{
+    Tree::AVLTree<std::string> tree = {"b", "d", "f", "h"};
+    std::vector<std::size_t> ranks;
+    tree.rank_batch({"a", "b", "c", "h", "z"}, ranks);
+    ASSERT_EQ(ranks, (std::vector<std::size_t>{0, 0, 1, 3, 4}));
+
+    std::vector<unsigned int> distances;
+    tree.distance_batch({{"b", "h"}, {"d", "f"}, {"c", "h"}}, distances);
+    ASSERT_EQ(distances, (std::vector<unsigned int>{3, 1, 0}));
+}
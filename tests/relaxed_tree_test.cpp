@@ -0,0 +1,138 @@
+#include "RelaxedAVLTree.hpp"
+#include <gtest/gtest.h>
+#include <climits>
+#include <iterator>
+#include <random>
+#include <set>
+
+class RelaxedAVLTree_int : public ::testing::Test
+{
+protected:
+    Tree::RelaxedAVLTree<int> obj;
+};
+
+
+TEST_F(RelaxedAVLTree_int, QueueUntilRead)
+{
+    for (int v : {5, 1, 3, 1, 9})
+        obj.insert(v);
+    obj.erase(3);
+
+    ASSERT_EQ(obj.pending_size(), 6);
+    ASSERT_NE(obj.find(9), nullptr);
+    ASSERT_EQ(obj.pending_size(), 0);
+    ASSERT_EQ(obj.find(3), nullptr);
+    ASSERT_EQ(obj.size(), 3);
+    ASSERT_EQ(std::set<int>(obj.begin(), obj.end()), (std::set<int>{1, 5, 9}));
+}
+
+
+TEST_F(RelaxedAVLTree_int, LastOperationWins)
+{
+    obj.insert(1);
+    obj.erase(1);
+    obj.insert(2);
+    obj.erase(2);
+    obj.insert(2);
+    obj.erase(7);
+
+    ASSERT_EQ(std::set<int>(obj.begin(), obj.end()), (std::set<int>{2}));
+}
+
+
+TEST_F(RelaxedAVLTree_int, BurstsAgainstStdSet)
+{
+    std::set<int> expected;
+    std::mt19937 gen(30);
+
+    for (int burst = 0; burst < 40; ++burst)
+    {
+        // large bursts rebuild, small bursts replay on the balanced tree
+        int length = (burst % 4 == 0) ? 2000 : 20;
+        for (int i = 0; i < length; ++i)
+        {
+            int v = gen() % 5000;
+            if (gen() % 3 == 0)
+            {
+                obj.erase(v);
+                expected.erase(v);
+            }
+            else
+            {
+                obj.insert(v);
+                expected.insert(v);
+            }
+        }
+
+        ASSERT_EQ(expected.size(), obj.size());
+        ASSERT_EQ(expected, std::set<int>(obj.begin(), obj.end()));
+    }
+
+    int lo = *expected.begin(), hi = *expected.rbegin();
+    ASSERT_EQ(expected.size() - 1, obj.distance(lo, hi));
+}
+
+
+TEST_F(RelaxedAVLTree_int, BoundedQueueAndFullTree)
+{
+    // the queue is applied once it holds max_pending operations
+    for (int v = 0; v < 70000; ++v)
+    {
+        obj.insert(v);
+        ASSERT_LT(obj.pending_size(), Tree::RelaxedAVLTree<int>::max_pending);
+    }
+
+    // 65535 elements at most: the new keys past that are dropped, reported and counted
+    // (the flush the 65536th insert ran dropped one)
+    ASSERT_EQ(obj.rebalance(), 70000u - USHRT_MAX - 1);
+    ASSERT_EQ(obj.size(), USHRT_MAX);
+    ASSERT_EQ(obj.dropped(), 70000u - USHRT_MAX);
+    ASSERT_EQ(std::distance(obj.begin(), obj.end()), USHRT_MAX);
+
+    // an erase in the same batch makes room for an insert
+    obj.erase(0);
+    obj.insert(-1);
+    ASSERT_EQ(obj.size(), USHRT_MAX);
+    ASSERT_NE(obj.find(-1), nullptr);
+    ASSERT_EQ(obj.dropped(), 70000u - USHRT_MAX);
+
+    obj.insert(-2);
+    ASSERT_EQ(obj.rebalance(), 1u);
+    ASSERT_EQ(obj.find(-2), nullptr);
+    ASSERT_EQ(obj.dropped(), 70000u - USHRT_MAX + 1);
+}
+
+
+TEST_F(RelaxedAVLTree_int, RebalanceInSteps)
+{
+    std::set<int> expected;
+    std::mt19937 gen(300);
+    for (int i = 0; i < 3000; ++i)
+    {
+        int v = gen() % 1000;
+        if (gen() % 3 == 0)
+        {
+            obj.erase(v);
+            expected.erase(v);
+        }
+        else
+        {
+            obj.insert(v);
+            expected.insert(v);
+        }
+
+        // a slice of the queue every few writes, in arrival order
+        if (i % 7 == 0)
+        {
+            std::size_t before = obj.pending_size(), dropped = 1;
+            bool done = obj.rebalance_step(5, &dropped);
+            ASSERT_EQ(obj.pending_size(), before > 5 ? before - 5 : 0);
+            ASSERT_EQ(done, obj.pending_size() == 0);
+            ASSERT_EQ(dropped, 0u);
+        }
+    }
+
+    while (!obj.rebalance_step(100));
+    ASSERT_EQ(obj.pending_size(), 0u);
+    ASSERT_EQ(expected, std::set<int>(obj.begin(), obj.end()));
+}
@@ -81,3 +81,23 @@ TEST_F(AVLTree_int, Swap)
     ASSERT_EQ(set1, std::set<int>(obj.begin(), obj.end()));
     ASSERT_EQ(set2, std::set<int>(obj1.begin(), obj1.end()));
 }
+
+
+TEST_F(AVLTree_int, RandomInsertEraseAgainstStdSet)
+{
+    std::set<int> expected;
+    unsigned int state = 12345;
+
+    for (int i = 0; i < 20000; ++i)
+    {
+        state = state * 1103515245 + 12345;
+        int v = (state >> 8) % 1000;
+        if ((state >> 4) % 3 == 0)
+            ASSERT_EQ(expected.erase(v) == 1, obj.erase(v));
+        else
+            ASSERT_EQ(expected.insert(v).second, obj.insert(v));
+    }
+
+    ASSERT_EQ(expected.size(), obj.size());
+    ASSERT_EQ(expected, std::set<int>(obj.begin(), obj.end()));
+}
@@ -0,0 +1,102 @@
+#include "ShardedAVLTree.hpp"
+#include <gtest/gtest.h>
+#include <random>
+#include <set>
+#include <thread>
+#include <vector>
+
+static std::vector<int> Contents(const Tree::ShardedAVLTree<int>& tree)
+{
+    std::vector<int> result;
+    tree.for_each([&](int value) { result.push_back(value); });
+    return result;
+}
+
+
+TEST(ShardedAVLTree, SplitsAndMerges)
+{
+    Tree::ShardedAVLTree<int> tree(64);
+    std::set<int> expected;
+    std::mt19937 gen(41);
+
+    for (int i = 0; i < 5000; ++i)
+    {
+        int v = static_cast<int>(gen() % 20000);
+        ASSERT_EQ(tree.insert(v), expected.insert(v).second);
+    }
+    ASSERT_EQ(tree.size(), expected.size());
+    ASSERT_GT(tree.shard_count(), expected.size() / 64);
+    ASSERT_EQ(Contents(tree), std::vector<int>(expected.begin(), expected.end()));
+
+    std::size_t shards = tree.shard_count();
+    for (int v = 0; v < 20000; ++v)
+    {
+        if (v % 50 != 0)
+        {
+            ASSERT_EQ(tree.erase(v), expected.erase(v) == 1);
+        }
+    }
+    ASSERT_LT(tree.shard_count(), shards);
+    ASSERT_EQ(tree.size(), expected.size());
+    ASSERT_EQ(Contents(tree), std::vector<int>(expected.begin(), expected.end()));
+
+    for (int v : expected)
+        ASSERT_TRUE(tree.contains(v));
+    ASSERT_FALSE(tree.contains(1));
+}
+
+
+TEST(ShardedAVLTree, GlobalDistance)
+{
+    Tree::ShardedAVLTree<int> tree(16);
+    for (int i = 0; i < 1000; ++i)
+        tree.insert(i * 2);
+    ASSERT_GT(tree.shard_count(), 10u);
+
+    ASSERT_EQ(tree.distance(0, 1998), 999u);
+    ASSERT_EQ(tree.distance(10, 20), 5u);
+    ASSERT_EQ(tree.distance(100, 1500), 700u);
+    ASSERT_EQ(tree.distance(20, 10), 0u);
+    ASSERT_EQ(tree.distance(1, 20), 0u);
+    ASSERT_EQ(tree.distance(8, 8), 0u);
+}
+
+
+TEST(ShardedAVLTree, PresetBounds)
+{
+    Tree::ShardedAVLTree<int> tree(std::vector<int>{100, 200, 300});
+    ASSERT_EQ(tree.shard_count(), 4u);
+
+    for (int v : {50, 100, 150, 250, 350, -5})
+        tree.insert(v);
+    ASSERT_EQ(Contents(tree), (std::vector<int>{-5, 50, 100, 150, 250, 350}));
+    ASSERT_EQ(tree.distance(-5, 350), 5u);
+}
+
+
+TEST(ShardedAVLTree, ConcurrentWriters)
+{
+    Tree::ShardedAVLTree<int> tree(256);
+    const int threads = 4, per_thread = 5000;
+
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t)
+    {
+        workers.emplace_back([&, t]() {
+            for (int i = 0; i < per_thread; ++i)
+                tree.insert(i * threads + t);
+            for (int i = 0; i < per_thread; i += 2)
+                tree.erase(i * threads + t);
+        });
+    }
+    for (std::thread& worker : workers)
+        worker.join();
+
+    std::vector<int> expected;
+    for (int i = 1; i < per_thread; i += 2)
+        for (int t = 0; t < threads; ++t)
+            expected.push_back(i * threads + t);
+
+    ASSERT_EQ(tree.size(), expected.size());
+    ASSERT_EQ(Contents(tree), expected);
+}
@@ -0,0 +1,154 @@
+#include "StringAVLTree.hpp"
+#include <gtest/gtest.h>
+#include <random>
+#include <set>
+#include <string>
+
+class StringAVLTree_test : public ::testing::Test
+{
+protected:
+    Tree::StringAVLTree<> obj;
+
+    std::set<std::string> contents(const Tree::StringAVLTree<>& tree) const
+    {
+        std::set<std::string> result;
+        for (const Tree::PrefixKey& key : tree)
+            result.insert(key.str());
+        return result;
+    }
+};
+
+
+TEST(PrefixKey, OrderMatchesStdString)
+{
+    std::string values[] = {"", "a", "ab", std::string("ab\0", 3), "abcdefgh", "abcdefghi", "abcdefgha",
+                            "abcdefgh\xff", "\xff", "b", "https://example.com/a", "https://example.com/b"};
+
+    for (const std::string& a : values)
+        for (const std::string& b : values)
+        {
+            Tree::PrefixKey ka(a), kb(b);
+            ASSERT_EQ(a < b, ka < kb) << a << " / " << b;
+            ASSERT_EQ(a == b, ka == kb) << a << " / " << b;
+            ASSERT_EQ(a > b, ka > kb) << a << " / " << b;
+        }
+}
+
+
+TEST_F(StringAVLTree_test, InsertFindErase)
+{
+    ASSERT_TRUE(obj.insert("https://example.com/index.html"));
+    ASSERT_TRUE(obj.insert("https://example.com/about.html"));
+    ASSERT_FALSE(obj.insert("https://example.com/index.html"));
+    ASSERT_EQ(obj.size(), 2);
+
+    ASSERT_NE(obj.find("https://example.com/about.html"), nullptr);
+    ASSERT_EQ(obj.find("https://example.com/about.html")->data.str(), "https://example.com/about.html");
+    ASSERT_EQ(obj.find("https://example.com/"), nullptr);
+
+    ASSERT_TRUE(obj.erase("https://example.com/index.html"));
+    ASSERT_FALSE(obj.erase("https://example.com/index.html"));
+    ASSERT_EQ(obj.size(), 1);
+}
+
+
+TEST_F(StringAVLTree_test, DuplicateDoesNotGrowPool)
+{
+    obj.insert(std::string(100, 'x'));
+    std::size_t capacity = obj.pool_capacity();
+    for (int i = 0; i < 10000; ++i)
+        ASSERT_FALSE(obj.insert(std::string(100, 'x')));
+    ASSERT_EQ(capacity, obj.pool_capacity());
+}
+
+
+TEST_F(StringAVLTree_test, RandomAgainstStdSet)
+{
+    std::mt19937 gen(27);
+    std::set<std::string> expected;
+
+    for (int i = 0; i < 3000; ++i)
+    {
+        std::string key = "https://host/" + std::to_string(gen() % 500) + "/" + std::to_string(gen() % 7);
+        if (gen() % 4 == 0)
+            ASSERT_EQ(expected.erase(key) == 1, obj.erase(key));
+        else
+            ASSERT_EQ(expected.insert(key).second, obj.insert(key));
+    }
+
+    ASSERT_EQ(expected, contents(obj));
+
+    Tree::StringAVLTree<> copy = obj;
+    obj.clear();
+    ASSERT_EQ(expected, contents(copy));
+    ASSERT_EQ(0, obj.size());
+}
+
+
+TEST(StringPool, MovedFromPoolDoesNotShareChunk)
+{
+    Tree::StringAVLTree<> a;
+    a.insert("alpha-alpha-alpha");
+
+    Tree::StringAVLTree<> b(std::move(a));
+    ASSERT_TRUE(b.insert("beta-beta-beta-beta"));
+    ASSERT_TRUE(a.insert("ZZZZ-ZZZZ-ZZZZ-ZZZZ"));
+
+    ASSERT_NE(b.find("beta-beta-beta-beta"), nullptr);
+    ASSERT_NE(b.find("alpha-alpha-alpha"), nullptr);
+    ASSERT_EQ(b.size(), 2);
+    ASSERT_NE(a.find("ZZZZ-ZZZZ-ZZZZ-ZZZZ"), nullptr);
+
+    Tree::StringAVLTree<> c;
+    c = std::move(b);
+    ASSERT_TRUE(b.insert("YYYY-YYYY-YYYY-YYYY"));
+    ASSERT_NE(c.find("beta-beta-beta-beta"), nullptr);
+    ASSERT_EQ(c.size(), 2);
+}
+
+
+TEST_F(StringAVLTree_test, ErasedStringsAreReclaimed)
+{
+    // insert / erase churn over a small live set, reclaim() when half the arena is dead: it stays bounded
+    const std::string padding(200, '.');
+    std::set<std::string> expected;
+    for (int i = 0; i < 20000; ++i)
+    {
+        std::string key = std::to_string(i) + padding;
+        ASSERT_TRUE(obj.insert(key));
+        expected.insert(key);
+        if (i >= 100)
+        {
+            std::string old = std::to_string(i - 100) + padding;
+            ASSERT_TRUE(obj.erase(old));
+            expected.erase(old);
+        }
+        if (obj.pool_dead() * 2 > obj.pool_capacity())
+            obj.reclaim();
+    }
+
+    ASSERT_EQ(expected, contents(obj));
+    ASSERT_LE(obj.pool_capacity(), 4u * 64 * 1024);
+}
+
+
+TEST_F(StringAVLTree_test, EraseKeepsOtherNodes)
+{
+    // erase() never reclaims by itself: pointers to the other keys stay valid however much is dead
+    ASSERT_TRUE(obj.insert("kept"));
+    const Tree::StringAVLTree<>::Node* kept = obj.find("kept");
+    for (int i = 0; i < 2000; ++i)
+    {
+        std::string key = std::to_string(i) + std::string(100, '-');
+        ASSERT_TRUE(obj.insert(key));
+        ASSERT_TRUE(obj.erase(key));
+        ASSERT_EQ(obj.find("kept"), kept);
+    }
+    ASSERT_GT(obj.pool_dead() * 2, obj.pool_capacity());
+    ASSERT_EQ(kept->data.str(), "kept");
+
+    obj.reclaim();
+    ASSERT_EQ(obj.pool_dead(), 0u);
+    ASSERT_LT(obj.pool_capacity(), 100u * 2000);
+    ASSERT_EQ(obj.find("kept")->data.str(), "kept");
+}
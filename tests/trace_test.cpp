@@ -0,0 +1,147 @@
+#include "TraceRecorder.hpp"
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+static std::string TracePath(const char* name)
+{
+    return ::testing::TempDir() + name;
+}
+
+
+TEST(TraceRecorder, RecordsEveryCall)
+{
+    const std::string path = TracePath("calls.avltrace");
+    {
+        Tree::TraceRecorder<int> recorder(path);
+        Tree::RecordingAVLTree<int, unsigned char, Tree::NoAugment, Tree::TraceRecorder<int>> tree;
+        tree.insert(1);
+
+        tree.record_to(&recorder);
+        ASSERT_TRUE(tree.insert(5));
+        ASSERT_TRUE(tree.insert(9));
+        ASSERT_FALSE(tree.erase(4));
+        ASSERT_NE(tree.find(5), nullptr);
+        ASSERT_EQ(tree.distance(1, 9), 2u);
+
+        int sum = 0;
+        for (int v : tree)
+            sum += v;
+        ASSERT_EQ(sum, 15);
+
+        tree.record_to(nullptr);
+        tree.insert(11);
+    }
+
+    std::vector<Tree::TraceRecord<int>> records = Tree::TraceReader<int>::read(path);
+    ASSERT_EQ(records.size(), 6u);
+
+    const Tree::TraceOp ops[] = { Tree::TraceOp::insert, Tree::TraceOp::insert, Tree::TraceOp::erase,
+        Tree::TraceOp::find, Tree::TraceOp::distance, Tree::TraceOp::iterate };
+    const int keys[] = { 5, 9, 4, 5, 1, 1 };
+    for (std::size_t i = 0; i < records.size(); ++i)
+    {
+        ASSERT_EQ(records[i].op, ops[i]);
+        ASSERT_EQ(records[i].key, keys[i]);
+        ASSERT_EQ(records[i].thread, 0);
+        if (i > 0)
+        {
+            ASSERT_GE(records[i].nanoseconds, records[i - 1].nanoseconds);
+        }
+    }
+    ASSERT_EQ(records[4].key2, 9);
+
+    std::uint16_t key_bytes;
+    char key_kind;
+    ASSERT_TRUE(Tree::TraceReader<int>::peek(path, key_bytes, key_kind));
+    ASSERT_EQ(key_bytes, sizeof(int));
+    ASSERT_EQ(key_kind, 'i');
+    ASSERT_THROW(Tree::TraceReader<long long>::read(path), std::runtime_error);
+    std::remove(path.c_str());
+}
+
+
+TEST(TraceRecorder, ReportsIoFailures)
+{
+    ASSERT_THROW(Tree::TraceReader<int>::read(TracePath("missing.avltrace")), std::runtime_error);
+    ASSERT_THROW(Tree::TraceRecorder<int>(TracePath("no/such/dir.avltrace")), std::runtime_error);
+
+    const std::string path = TracePath("flush.avltrace");
+    {
+        Tree::TraceRecorder<int> recorder(path);
+        recorder.record(Tree::TraceOp::insert, 3);
+        ASSERT_TRUE(recorder.flush());
+    }
+    ASSERT_EQ(Tree::TraceReader<int>::read(path).size(), 1u);
+    std::remove(path.c_str());
+
+#ifdef __linux__
+    // every write to /dev/full fails with ENOSPC
+    Tree::TraceRecorder<int> full("/dev/full");
+    full.record(Tree::TraceOp::insert, 3);
+    ASSERT_FALSE(full.flush());
+    ASSERT_FALSE(full.flush());
+#endif
+}
+
+
+TEST(TraceRecorder, ThreadIds)
+{
+    const std::string path = TracePath("threads.avltrace");
+    {
+        Tree::TraceRecorder<double> recorder(path);
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 3; ++t)
+        {
+            threads.emplace_back([&recorder, t]() {
+                for (int i = 0; i < 1000; ++i)
+                    recorder.record(Tree::TraceOp::find, t + 0.5);
+            });
+        }
+        for (std::thread& thread : threads)
+            thread.join();
+    }
+
+    std::vector<Tree::TraceRecord<double>> records = Tree::TraceReader<double>::read(path);
+    ASSERT_EQ(records.size(), 3000u);
+
+    // one small id per thread, always with the same key
+    std::vector<double> key_of(3, -1);
+    for (const Tree::TraceRecord<double>& record : records)
+    {
+        ASSERT_LT(record.thread, 3);
+        if (key_of[record.thread] < 0)
+            key_of[record.thread] = record.key;
+        ASSERT_EQ(record.key, key_of[record.thread]);
+    }
+    std::remove(path.c_str());
+}
+
+
+TEST(TraceRecorder, NoRecorderIsAPlainTree)
+{
+    Tree::RecordingAVLTree<int> tree = {3, 1, 2};
+    ASSERT_EQ(tree.size(), 3);
+    ASSERT_EQ(*tree.begin(), 1);
+    ASSERT_TRUE(tree.erase(2));
+    ASSERT_EQ(tree.find(2), nullptr);
+    ASSERT_TRUE(tree.check_invariants());
+}
+
+
+TEST(TraceRecorder, KeepsTheBalancingPolicy)
+{
+    Tree::RecordingAVLTree<int, unsigned char, Tree::NoAugment, Tree::NoRecorder<int>, Tree::WAVLBalancing> tree;
+    static_assert(std::is_base_of<Tree::AVLTree<int, unsigned char, Tree::NoAugment, Tree::WAVLBalancing>, decltype(tree)>::value,
+        "the recording tree runs on the policy it is given");
+
+    for (int i = 0; i < 1000; ++i)
+        ASSERT_TRUE(tree.insert(i * 7 % 1000));
+    for (int i = 0; i < 1000; i += 3)
+        ASSERT_TRUE(tree.erase(i));
+    ASSERT_TRUE(tree.check_invariants());
+    ASSERT_EQ(tree.size(), 666);
+}
@@ -0,0 +1,328 @@
+#include "AVLTree.hpp"
+#include "HugePageStorage.hpp"
+#include "ShardedAVLTree.hpp"
+#include "TraceRecorder.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+// avltree_replay: replay a TraceRecorder trace against one tree configuration, print per-op latency histograms
+//
+// usage: avltree_replay <trace> [--tree avl|hugepage|sharded|set] [--threads] [--paced]
+//   --tree     container the trace runs on (default avl; set = std::set as a reference)
+//   --threads  one replay thread per recorded thread (the tree is shared: avl / hugepage / set under one mutex)
+//   --paced    keep the recorded timing (one clock for all threads) instead of replaying back to back
+
+namespace
+{
+	const char* const op_names[] = { "insert", "erase", "find", "distance", "iterate" };
+	const int op_count = 5;
+
+	// Latency Histogram: power-of-two nanosecond buckets + exact samples for percentiles
+	struct Histogram
+	{
+		std::vector<std::uint32_t> samples;
+
+		void add(std::uint64_t nanoseconds)
+		{
+			samples.push_back(static_cast<std::uint32_t>(std::min<std::uint64_t>(nanoseconds, UINT32_MAX)));
+		}
+
+		void merge(const Histogram& other)
+		{
+			samples.insert(samples.end(), other.samples.begin(), other.samples.end());
+		}
+
+		void print(const char* name)
+		{
+			if (samples.empty())
+				return;
+
+			std::sort(samples.begin(), samples.end());
+			auto at = [&](double fraction) { return samples[static_cast<std::size_t>(fraction * (samples.size() - 1))]; };
+			std::printf("%-9s %10zu calls  p50 %8u  p99 %8u  p99.9 %8u  max %8u ns\n",
+				name, samples.size(), at(0.5), at(0.99), at(0.999), samples.back());
+
+			std::size_t buckets[33] = {};
+			for (std::uint32_t sample : samples)
+			{
+				int bucket = 0;
+				while (bucket < 32 && (std::uint64_t(1) << (bucket + 1)) <= sample)
+					++bucket;
+				++buckets[bucket];
+			}
+
+			std::size_t widest = *std::max_element(buckets, buckets + 33);
+			for (int bucket = 0; bucket < 33; ++bucket)
+			{
+				if (buckets[bucket] == 0)
+					continue;
+				std::printf("  %10llu ns  %10zu  %s\n", 1ULL << bucket, buckets[bucket],
+					std::string(1 + buckets[bucket] * 50 / widest, '#').c_str());
+			}
+		}
+	};
+
+	// Same Calls On Every Configuration: insert / erase / find / distance / iterate
+	template<typename K, typename Storage>
+	struct AVLTarget
+	{
+		Tree::AVLTree<K, unsigned char, Storage> tree;
+		std::mutex lock;
+
+		template<typename F>
+		std::size_t locked(bool shared, F f)
+		{
+			if (!shared)
+				return f();
+			std::lock_guard<std::mutex> guard(lock);
+			return f();
+		}
+
+		std::size_t run(const Tree::TraceRecord<K>& record, bool shared)
+		{
+			return locked(shared, [&]() -> std::size_t {
+				switch (record.op)
+				{
+				case Tree::TraceOp::insert: return tree.insert(record.key);
+				case Tree::TraceOp::erase: return tree.erase(record.key);
+				case Tree::TraceOp::find: return tree.find(record.key) != nullptr;
+				case Tree::TraceOp::distance: return tree.distance(record.key, record.key2);
+				case Tree::TraceOp::iterate:
+				{
+					std::size_t walked = 0;
+					for (auto it = tree.cursor_begin(); it != tree.cursor_end(); ++it)
+						++walked;
+					return walked;
+				}
+				}
+				return 0;
+			});
+		}
+	};
+
+	template<typename K>
+	struct ShardedTarget
+	{
+		Tree::ShardedAVLTree<K> tree;
+
+		std::size_t run(const Tree::TraceRecord<K>& record, bool)
+		{
+			switch (record.op)
+			{
+			case Tree::TraceOp::insert: return tree.insert(record.key);
+			case Tree::TraceOp::erase: return tree.erase(record.key);
+			case Tree::TraceOp::find: return tree.contains(record.key);
+			case Tree::TraceOp::distance: return tree.distance(record.key, record.key2);
+			case Tree::TraceOp::iterate:
+			{
+				std::size_t walked = 0;
+				tree.for_each([&](const K&) { ++walked; });
+				return walked;
+			}
+			}
+			return 0;
+		}
+	};
+
+	template<typename K>
+	struct SetTarget
+	{
+		std::set<K> tree;
+		std::mutex lock;
+
+		std::size_t run(const Tree::TraceRecord<K>& record, bool shared)
+		{
+			std::unique_lock<std::mutex> guard(lock, std::defer_lock);
+			if (shared)
+				guard.lock();
+
+			switch (record.op)
+			{
+			case Tree::TraceOp::insert: return tree.insert(record.key).second;
+			case Tree::TraceOp::erase: return tree.erase(record.key);
+			case Tree::TraceOp::find: return tree.count(record.key);
+			case Tree::TraceOp::distance:
+			{
+				auto first = tree.find(record.key), last = tree.find(record.key2);
+				return (first != tree.end() && last != tree.end() && record.key < record.key2)
+					? static_cast<std::size_t>(std::distance(first, last)) : 0;
+			}
+			case Tree::TraceOp::iterate:
+			{
+				std::size_t walked = 0;
+				for (auto it = tree.begin(); it != tree.end(); ++it)
+					++walked;
+				return walked;
+			}
+			}
+			return 0;
+		}
+	};
+
+	// Replay records Of One Thread (all of them when threads is off), Timing Every Call. paced: a record
+	// recorded at first + t runs at start + t, first being the earliest timestamp of the whole trace.
+	// Returns the sum of the call results, so the calls cannot be optimized out
+	template<typename K, typename Target>
+	std::size_t ReplayThread(Target& target, const std::vector<Tree::TraceRecord<K>>& records, bool shared, bool paced,
+		std::chrono::steady_clock::time_point start, std::uint64_t first, Histogram* histograms)
+	{
+		std::size_t sink = 0;
+
+		for (const Tree::TraceRecord<K>& record : records)
+		{
+			if (paced)
+				std::this_thread::sleep_until(start + std::chrono::nanoseconds(record.nanoseconds - first));
+
+			auto before = std::chrono::steady_clock::now();
+			sink += target.run(record, shared);
+			auto after = std::chrono::steady_clock::now();
+
+			if (static_cast<int>(record.op) < op_count)
+				histograms[static_cast<int>(record.op)].add(static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(after - before).count()));
+		}
+
+		return sink;
+	}
+
+	template<typename K, typename Target>
+	int Replay(const std::string& path, bool threads, bool paced)
+	{
+		std::vector<Tree::TraceRecord<K>> records = Tree::TraceReader<K>::read(path);
+		Target target;
+		Histogram total[op_count];
+		std::size_t sink = 0;
+
+		// threads buffer apart, so the file is not in time order: pacing starts from the earliest record
+		std::uint64_t first = 0;
+		if (!records.empty())
+		{
+			first = std::min_element(records.begin(), records.end(), [](const Tree::TraceRecord<K>& lhs, const Tree::TraceRecord<K>& rhs) {
+				return lhs.nanoseconds < rhs.nanoseconds;
+			})->nanoseconds;
+		}
+
+		auto start = std::chrono::steady_clock::now();
+		if (!threads)
+			sink = ReplayThread<K>(target, records, false, paced, start, first, total);
+		else
+		{
+			std::map<std::uint16_t, std::vector<Tree::TraceRecord<K>>> per_thread;
+			for (const Tree::TraceRecord<K>& record : records)
+				per_thread[record.thread].push_back(record);
+
+			std::vector<std::vector<Histogram>> histograms(per_thread.size(), std::vector<Histogram>(op_count));
+			std::vector<std::size_t> sinks(per_thread.size());
+			std::vector<std::thread> workers;
+			std::size_t index = 0;
+			for (auto& thread : per_thread)
+			{
+				Histogram* own = histograms[index].data();
+				std::size_t* own_sink = &sinks[index++];
+				const std::vector<Tree::TraceRecord<K>>* own_records = &thread.second;
+				workers.emplace_back([&target, own, own_sink, own_records, paced, start, first]() {
+					*own_sink = ReplayThread<K>(target, *own_records, true, paced, start, first, own);
+				});
+			}
+			for (std::thread& worker : workers)
+				worker.join();
+
+			for (std::size_t i = 0; i < histograms.size(); ++i)
+			{
+				sink += sinks[i];
+				for (int op = 0; op < op_count; ++op)
+					total[op].merge(histograms[i][op]);
+			}
+		}
+		double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+		std::printf("%zu records, %s, %.3f s (%.2f Mops/s), result sum %zu\n", records.size(),
+			threads ? "one thread per recorded thread" : "one thread", seconds, records.size() / seconds / 1e6, sink);
+		for (int op = 0; op < op_count; ++op)
+			total[op].print(op_names[op]);
+
+		return 0;
+	}
+
+	template<typename K>
+	int ReplayOn(const std::string& path, const std::string& tree, bool threads, bool paced)
+	{
+		if (tree == "avl")
+			return Replay<K, AVLTarget<K, Tree::NoAugment>>(path, threads, paced);
+		if (tree == "hugepage")
+			return Replay<K, AVLTarget<K, Tree::HugePageStorage<>>>(path, threads, paced);
+		if (tree == "sharded")
+			return Replay<K, ShardedTarget<K>>(path, threads, paced);
+		if (tree == "set")
+			return Replay<K, SetTarget<K>>(path, threads, paced);
+
+		std::fprintf(stderr, "unknown --tree %s (avl, hugepage, sharded, set)\n", tree.c_str());
+		return 2;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	if (argc < 2)
+	{
+		std::fprintf(stderr, "usage: %s <trace> [--tree avl|hugepage|sharded|set] [--threads] [--paced]\n", argv[0]);
+		return 2;
+	}
+
+	const std::string path = argv[1];
+	std::string tree = "avl";
+	bool threads = false, paced = false;
+	for (int i = 2; i < argc; ++i)
+	{
+		if (std::strcmp(argv[i], "--tree") == 0 && i + 1 < argc)
+			tree = argv[++i];
+		else if (std::strcmp(argv[i], "--threads") == 0)
+			threads = true;
+		else if (std::strcmp(argv[i], "--paced") == 0)
+			paced = true;
+		else
+		{
+			std::fprintf(stderr, "unknown option %s\n", argv[i]);
+			return 2;
+		}
+	}
+
+	// the key type of the trace picks the instantiation
+	std::uint16_t key_bytes = 0;
+	char key_kind = 0;
+	if (!Tree::TraceReader<int>::peek(path, key_bytes, key_kind))
+	{
+		std::fprintf(stderr, "%s is not an AVLTree trace\n", path.c_str());
+		return 1;
+	}
+
+	try
+	{
+		if (key_kind == 'i' && key_bytes == 4)
+			return ReplayOn<std::int32_t>(path, tree, threads, paced);
+		if (key_kind == 'i' && key_bytes == 8)
+			return ReplayOn<std::int64_t>(path, tree, threads, paced);
+		if (key_kind == 'u' && key_bytes == 4)
+			return ReplayOn<std::uint32_t>(path, tree, threads, paced);
+		if (key_kind == 'u' && key_bytes == 8)
+			return ReplayOn<std::uint64_t>(path, tree, threads, paced);
+		if (key_kind == 'f' && key_bytes == 8)
+			return ReplayOn<double>(path, tree, threads, paced);
+	}
+	catch (const std::exception& error)
+	{
+		std::fprintf(stderr, "%s\n", error.what());
+		return 1;
+	}
+
+	std::fprintf(stderr, "unsupported key: %u bytes, kind '%c' (int32, int64, uint32, uint64, double)\n", key_bytes, key_kind);
+	return 1;
+}